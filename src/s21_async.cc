@@ -0,0 +1,20 @@
+#include "s21_async.h"
+
+// Creates the exception with the common message
+S21OperationCancelled::S21OperationCancelled()
+    : std::runtime_error("The operation was cancelled") {}
+
+// Creates a token that isn't cancelled
+S21CancellationToken::S21CancellationToken()
+    : cancelled_(std::make_shared<std::atomic<bool>>(false)) {}
+
+// Checks if any copy of the token was cancelled
+bool S21CancellationToken::IsCancelled() const noexcept { return *cancelled_; }
+
+// Asks every operation holding a copy of the token to stop
+void S21CancellationToken::Cancel() noexcept { *cancelled_ = true; }
+
+// Throws S21OperationCancelled if the token was cancelled
+void S21CancellationToken::ThrowIfCancelled() const {
+  if (*cancelled_) throw S21OperationCancelled();
+}
@@ -0,0 +1,53 @@
+#ifndef S21_ASYNC_H
+#define S21_ASYNC_H
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+#include "s21_thread_pool.h"
+
+// Thrown into the future of an asynchronous operation that was cancelled
+class S21OperationCancelled : public std::runtime_error {
+ public:
+  S21OperationCancelled();
+};
+
+// Receives the completed fraction of an asynchronous operation, from 0 to 1.
+// It is called on the thread running the operation
+using S21ProgressCallback = std::function<void(double)>;
+
+// Cancellation flag shared by all copies of the token. An operation checks it
+// between its steps, so cancelling stops the operation at the next step
+// boundary, not in the middle of a kernel
+class S21CancellationToken {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  S21CancellationToken();
+
+  /* ======================== Accessors and mutatos ========================= */
+  bool IsCancelled() const noexcept;
+
+  /* ============================== Functions =============================== */
+  void Cancel() noexcept;
+  void ThrowIfCancelled() const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+// Runs the body on the library thread pool and returns the future of its
+// result. Without worker threads the body runs before the function returns
+template <typename Body>
+auto S21RunAsync(Body body) -> std::future<decltype(body())> {
+  using Result = decltype(body());
+  auto task = std::make_shared<std::packaged_task<Result()>>(std::move(body));
+  std::future<Result> result = task->get_future();
+  S21ThreadPool::Instance().Post([task] { (*task)(); });
+  return result;
+}
+
+#endif  // S21_ASYNC_H
@@ -0,0 +1,456 @@
+#include "s21_band.h"
+
+#include <algorithm>
+
+#include "s21_gemm.h"
+#include "s21_thread_pool.h"
+
+// Band matrix-vector products with fewer stored cells than this run on one
+// thread
+static constexpr long long kParallelCells = 1LL << 15;
+// Minimal number of rows given to one thread by MulVector
+static constexpr int kRowGrain = 1 << 12;
+// Minimal number of equations given to one thread on a level of the cyclic
+// reduction
+static constexpr int kReductionGrain = 1 << 12;
+
+// Default constructor
+S21BandMatrix::S21BandMatrix() noexcept : size_{}, lower_{}, upper_{} {}
+
+// Creates a zero band matrix of the given order and bandwidths
+S21BandMatrix::S21BandMatrix(int size, int lower, int upper) {
+  if (size < 1) {
+    throw std::invalid_argument("Size can't be less than 1");
+  }
+  if (lower < 0 || upper < 0) {
+    throw std::invalid_argument("Bandwidths can't be less than 0");
+  }
+  size_ = size;
+  lower_ = lower;
+  upper_ = upper;
+  band_.assign(static_cast<size_t>(size_) * Width(), 0.0);
+}
+
+// Copies the band of a square dense matrix, elements outside of it are dropped
+S21BandMatrix::S21BandMatrix(const S21Matrix &matrix, int lower, int upper)
+    : S21BandMatrix(matrix.GetRows(), lower, upper) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("The matrix is not square");
+  }
+  for (int i = 0; i < size_; i++) {
+    const int first = std::max(0, i - lower_);
+    const int last = std::min(size_ - 1, i + upper_);
+    for (int j = first; j <= last; j++) {
+      (*this)(i, j) = matrix(i, j);
+    }
+  }
+}
+
+// Returns the order of the matrix
+int S21BandMatrix::GetSize() const noexcept { return size_; }
+
+// Returns the number of diagonals below the main one
+int S21BandMatrix::GetLower() const noexcept { return lower_; }
+
+// Returns the number of diagonals above the main one
+int S21BandMatrix::GetUpper() const noexcept { return upper_; }
+
+// Returns the number of stored elements per row
+int S21BandMatrix::Width() const noexcept { return lower_ + upper_ + 1; }
+
+// Checks if the element is inside the matrix and its band
+void S21BandMatrix::CheckIfIndexExists(int row, int col) const {
+  if (row < 0 || col < 0) {
+    throw std::out_of_range("Row or column can't be less than zero");
+  } else if (row >= size_ || col >= size_) {
+    throw std::out_of_range("Row or column doesn't exist");
+  } else if (col < row - lower_ || col > row + upper_) {
+    throw std::out_of_range("The element is outside of the band");
+  }
+}
+
+// Returns y = A * x. Every element is the dot product of a contiguous row of
+// the band with a contiguous part of x, rows are split between threads
+S21Vector S21BandMatrix::MulVector(const S21Vector &vector) const {
+  if (vector.GetSize() != size_) {
+    throw std::invalid_argument("Invalid sizes of matrix and vector");
+  }
+  S21Vector result(size_);
+  const double *x = vector.Data();
+  double *y = result.Data();
+  const double *band = band_.data();
+  const int n = size_, lower = lower_, upper = upper_, width = Width();
+  const long long cells = static_cast<long long>(n) * width;
+  S21ThreadPool::Instance().ParallelFor(
+      0, n, cells < kParallelCells ? n : kRowGrain,
+      [x, y, band, n, lower, upper, width](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          const int first = std::max(0, i - lower);
+          const int last = std::min(n - 1, i + upper);
+          const double *row =
+              band + static_cast<size_t>(i) * width + (first - i + lower);
+          y[i] = S21Dot(row, x + first, last - first + 1);
+        }
+      });
+  return result;
+}
+
+// Checks that the matrix is tridiagonal and the right-hand side fits it
+void S21BandMatrix::CheckTridiagonal(const S21Vector &rhs) const {
+  if (lower_ != 1 || upper_ != 1) {
+    throw std::logic_error("The matrix is not tridiagonal");
+  }
+  if (rhs.GetSize() != size_) {
+    throw std::invalid_argument(
+        "Right-hand side size is not equal to the matrix size");
+  }
+}
+
+// Solves a tridiagonal system with the Thomas algorithm in O(n). There is no
+// pivoting, so the matrix should be diagonally dominant or positive-definite
+S21Vector S21BandMatrix::SolveTridiagonal(const S21Vector &rhs) const {
+  CheckTridiagonal(rhs);
+  const int n = size_;
+  // Row i of the band holds a_i, b_i, c_i: the coefficients of x_(i-1), x_i
+  // and x_(i+1)
+  const double *band = band_.data();
+  std::vector<double> upper(n);
+  S21Vector solution(rhs);
+  double *x = solution.Data();
+  for (int i = 0; i < n; i++) {
+    const double *row = band + 3 * static_cast<size_t>(i);
+    const double pivot = i ? row[1] - row[0] * upper[i - 1] : row[1];
+    if (pivot == 0) {
+      throw std::logic_error("The matrix is singular");
+    }
+    upper[i] = row[2] / pivot;
+    x[i] = (x[i] - (i ? row[0] * x[i - 1] : 0)) / pivot;
+  }
+  for (int i = n - 2; i >= 0; i--) {
+    x[i] -= upper[i] * x[i + 1];
+  }
+  return solution;
+}
+
+// Eliminates x_(i - s) and x_(i + s) from the equations i = first + k * step,
+// k in [begin, end), of the tridiagonal system stored in rows of three
+static void ReduceLevel(double *a, double *d, int n, int stride, int begin,
+                        int end) {
+  for (int k = begin; k < end; k++) {
+    const int i = 2 * stride - 1 + k * 2 * stride;
+    double *row = a + 3 * static_cast<size_t>(i);
+    const double *left = row - 3 * stride;
+    if (left[1] == 0) {
+      throw std::logic_error("The matrix is singular");
+    }
+    const double alpha = -row[0] / left[1];
+    row[1] += alpha * left[2];
+    d[i] += alpha * d[i - stride];
+    row[0] = alpha * left[0];
+    if (i + stride < n) {
+      const double *next = row + 3 * stride;
+      if (next[1] == 0) {
+        throw std::logic_error("The matrix is singular");
+      }
+      const double gamma = -row[2] / next[1];
+      row[1] += gamma * next[0];
+      d[i] += gamma * d[i + stride];
+      row[2] = gamma * next[2];
+    } else {
+      row[2] = 0;
+    }
+  }
+}
+
+// Finds x_i for i = stride - 1 + k * 2 * stride, k in [begin, end), from the
+// already known x_(i - stride) and x_(i + stride)
+static void SubstituteLevel(const double *a, const double *d, double *x, int n,
+                            int stride, int begin, int end) {
+  for (int k = begin; k < end; k++) {
+    const int i = stride - 1 + k * 2 * stride;
+    const double *row = a + 3 * static_cast<size_t>(i);
+    double value = d[i];
+    if (i - stride >= 0) value -= row[0] * x[i - stride];
+    if (i + stride < n) value -= row[2] * x[i + stride];
+    if (row[1] == 0) {
+      throw std::logic_error("The matrix is singular");
+    }
+    x[i] = value / row[1];
+  }
+}
+
+// Solves a tridiagonal system by cyclic reduction. On the level with stride s
+// every equation i = 2s - 1 (mod 2s) eliminates its neighbours i - s and i + s
+// and then couples only to i - 2s and i + 2s; the equations of one level are
+// independent and split between threads. Back substitution walks the levels in
+// reverse, again in parallel. The work is O(n) and the depth O(log n)
+S21Vector S21BandMatrix::SolveTridiagonalParallel(const S21Vector &rhs) const {
+  CheckTridiagonal(rhs);
+  const int n = size_;
+  std::vector<double> band(band_);
+  std::vector<double> right(rhs.Data(), rhs.Data() + n);
+  double *a = band.data(), *d = right.data();
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  int stride = 1;
+  for (; 2 * stride - 1 < n; stride *= 2) {
+    const int count = (n - 2 * stride) / (2 * stride) + 1;
+    pool.ParallelFor(0, count, kReductionGrain,
+                     [a, d, n, stride](int begin, int end) {
+                       ReduceLevel(a, d, n, stride, begin, end);
+                     });
+  }
+  S21Vector solution(n);
+  double *x = solution.Data();
+  for (; stride >= 1; stride /= 2) {
+    const int count = (n - stride) / (2 * stride) + 1;
+    pool.ParallelFor(0, count, kReductionGrain,
+                     [a, d, x, n, stride](int begin, int end) {
+                       SubstituteLevel(a, d, x, n, stride, begin, end);
+                     });
+  }
+  return solution;
+}
+
+// Returns the matrix in dense storage
+S21Matrix S21BandMatrix::ToMatrix() const {
+  S21Matrix dense(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    const int first = std::max(0, i - lower_);
+    const int last = std::min(size_ - 1, i + upper_);
+    for (int j = first; j <= last; j++) {
+      dense(i, j) = (*this)(i, j);
+    }
+  }
+  return dense;
+}
+
+// Returns the element inside the band at the specified row and column
+double &S21BandMatrix::operator()(int row, int col) {
+  CheckIfIndexExists(row, col);
+  return band_[static_cast<size_t>(row) * Width() + (col - row + lower_)];
+}
+
+// Returns the element at the specified row and column, zero outside the band
+double S21BandMatrix::operator()(int row, int col) const {
+  if (row >= 0 && col >= 0 && row < size_ && col < size_ &&
+      (col < row - lower_ || col > row + upper_)) {
+    return 0;
+  }
+  CheckIfIndexExists(row, col);
+  return band_[static_cast<size_t>(row) * Width() + (col - row + lower_)];
+}
+
+// Factorizes the band matrix
+S21BandLU::S21BandLU(const S21BandMatrix &matrix)
+    : size_(matrix.size_),
+      lower_(matrix.lower_),
+      upper_(matrix.upper_),
+      pivots_(matrix.size_),
+      singular_(false) {
+  if (size_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+  lu_.assign(static_cast<size_t>(size_) * Width(), 0.0);
+  const int width = matrix.Width();
+  for (int i = 0; i < size_; i++) {
+    std::copy(matrix.band_.begin() + static_cast<size_t>(i) * width,
+              matrix.band_.begin() + static_cast<size_t>(i + 1) * width,
+              lu_.begin() + static_cast<size_t>(i) * Width());
+  }
+  Factorize();
+}
+
+// Returns the order of the matrix
+int S21BandLU::GetSize() const noexcept { return size_; }
+
+// Checks if a zero pivot was met
+bool S21BandLU::IsSingular() const noexcept { return singular_; }
+
+// Returns the number of stored elements per row: the lower band, the diagonal
+// and the upper band widened by the row swaps
+int S21BandLU::Width() const noexcept { return 2 * lower_ + upper_ + 1; }
+
+// Returns the element at the specified row and column, which must be within
+// row - kl .. row + kl + ku
+double &S21BandLU::At(int row, int col) noexcept {
+  return lu_[static_cast<size_t>(row) * Width() + (col - row + lower_)];
+}
+
+// Returns the element at the specified row and column, which must be within
+// row - kl .. row + kl + ku
+const double &S21BandLU::At(int row, int col) const noexcept {
+  return lu_[static_cast<size_t>(row) * Width() + (col - row + lower_)];
+}
+
+// Gaussian elimination with partial pivoting restricted to the band, every row
+// update is one contiguous axpy of length at most kl + ku. The work is
+// O(n * kl * (kl + ku))
+void S21BandLU::Factorize() {
+  const int n = size_;
+  for (int k = 0; k < n; k++) {
+    const int last_row = std::min(n - 1, k + lower_);
+    const int last_col = std::min(n - 1, k + lower_ + upper_);
+    int pivot = k;
+    for (int i = k + 1; i <= last_row; i++) {
+      if (fabs(At(i, k)) > fabs(At(pivot, k))) pivot = i;
+    }
+    pivots_[k] = pivot;
+    if (At(pivot, k) == 0) {
+      singular_ = true;
+      return;
+    }
+    if (pivot != k) {
+      for (int j = k; j <= last_col; j++) {
+        std::swap(At(k, j), At(pivot, j));
+      }
+    }
+    const double inverse = 1.0 / At(k, k);
+    for (int i = k + 1; i <= last_row; i++) {
+      const double factor = At(i, k) * inverse;
+      At(i, k) = factor;
+      if (factor != 0 && last_col > k) {
+        S21Axpy(-factor, &At(k, k + 1), &At(i, k + 1), last_col - k);
+      }
+    }
+  }
+}
+
+// Solves A * x = rhs: the row swaps and L are applied to rhs, then U is
+// solved backwards
+S21Vector S21BandLU::Solve(const S21Vector &rhs) const {
+  if (rhs.GetSize() != size_) {
+    throw std::invalid_argument(
+        "Right-hand side size is not equal to the matrix size");
+  }
+  if (singular_) {
+    throw std::logic_error("The matrix is singular");
+  }
+  const int n = size_;
+  S21Vector solution(rhs);
+  double *x = solution.Data();
+  for (int k = 0; k < n; k++) {
+    std::swap(x[k], x[pivots_[k]]);
+    const int last_row = std::min(n - 1, k + lower_);
+    for (int i = k + 1; i <= last_row; i++) {
+      x[i] -= At(i, k) * x[k];
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    const int last_col = std::min(n - 1, i + lower_ + upper_);
+    double value = x[i];
+    if (last_col > i) {
+      value -= S21Dot(&At(i, i + 1), x + i + 1, last_col - i);
+    }
+    x[i] = value / At(i, i);
+  }
+  return solution;
+}
+
+// Returns log |det A|, the determinant itself overflows for large matrices
+double S21BandLU::LogAbsDeterminant() const {
+  if (singular_) {
+    throw std::logic_error("The matrix is singular");
+  }
+  double sum = 0;
+  for (int i = 0; i < size_; i++) {
+    sum += log(fabs(At(i, i)));
+  }
+  return sum;
+}
+
+// Factorizes the lower band of the matrix
+S21BandCholesky::S21BandCholesky(const S21BandMatrix &matrix)
+    : size_(matrix.size_), lower_(matrix.lower_), positive_definite_(false) {
+  if (size_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+  factor_.assign(static_cast<size_t>(size_) * (lower_ + 1), 0.0);
+  const int width = matrix.Width();
+  for (int i = 0; i < size_; i++) {
+    const auto row = matrix.band_.begin() + static_cast<size_t>(i) * width;
+    std::copy(row, row + lower_ + 1,
+              factor_.begin() + static_cast<size_t>(i) * (lower_ + 1));
+  }
+  Factorize();
+}
+
+// Returns the order of the matrix
+int S21BandCholesky::GetSize() const noexcept { return size_; }
+
+// Checks if the factorization succeeded
+bool S21BandCholesky::IsPositiveDefinite() const noexcept {
+  return positive_definite_;
+}
+
+// Row-oriented Cholesky restricted to the band. Row i of L keeps columns
+// i - kl .. i, so every element is a dot product of two contiguous row parts.
+// The work is O(n * kl^2)
+void S21BandCholesky::Factorize() {
+  const int n = size_, width = lower_ + 1;
+  double *factor = factor_.data();
+  for (int i = 0; i < n; i++) {
+    double *row = factor + static_cast<size_t>(i) * width;
+    const int first = std::max(0, i - lower_);
+    for (int j = first; j <= i; j++) {
+      const double *other = factor + static_cast<size_t>(j) * width;
+      // Columns first .. j - 1 of rows i and j
+      double value = row[j - i + lower_] -
+                     S21Dot(row + (first - i + lower_),
+                            other + (first - j + lower_), j - first);
+      if (j < i) {
+        row[j - i + lower_] = value / other[lower_];
+      } else if (value > 0) {
+        row[lower_] = sqrt(value);
+      } else {
+        return;
+      }
+    }
+  }
+  positive_definite_ = true;
+}
+
+// Checks if the factorization can solve the system
+void S21BandCholesky::CheckUsable(const S21Vector &rhs) const {
+  if (!positive_definite_) {
+    throw std::logic_error("The matrix is not symmetric positive-definite");
+  }
+  if (rhs.GetSize() != size_) {
+    throw std::invalid_argument(
+        "Right-hand side size is not equal to the matrix size");
+  }
+}
+
+// Solves L * y = rhs by dot products with the rows of L, then L^T * x = y by
+// subtracting scaled rows of L
+S21Vector S21BandCholesky::Solve(const S21Vector &rhs) const {
+  CheckUsable(rhs);
+  const int n = size_, width = lower_ + 1;
+  const double *factor = factor_.data();
+  S21Vector solution(rhs);
+  double *x = solution.Data();
+  for (int i = 0; i < n; i++) {
+    const double *row = factor + static_cast<size_t>(i) * width;
+    const int first = std::max(0, i - lower_);
+    x[i] = (x[i] - S21Dot(row + (first - i + lower_), x + first, i - first)) /
+           row[lower_];
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    const double *row = factor + static_cast<size_t>(i) * width;
+    const int first = std::max(0, i - lower_);
+    x[i] /= row[lower_];
+    S21Axpy(-x[i], row + (first - i + lower_), x + first, i - first);
+  }
+  return solution;
+}
+
+// Returns log det A = 2 * sum log L(i, i)
+double S21BandCholesky::LogDeterminant() const {
+  if (!positive_definite_) {
+    throw std::logic_error("The matrix is not symmetric positive-definite");
+  }
+  double sum = 0;
+  for (int i = 0; i < size_; i++) {
+    sum += log(factor_[static_cast<size_t>(i) * (lower_ + 1) + lower_]);
+  }
+  return 2 * sum;
+}
@@ -0,0 +1,107 @@
+#ifndef S21_BAND_H
+#define S21_BAND_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_vector.h"
+
+// Square matrix with lower bandwidth kl and upper bandwidth ku: only elements
+// with -kl <= col - row <= ku are stored. Row i keeps columns i - kl .. i + ku
+// contiguously, so the storage is n * (kl + ku + 1) elements and a row of the
+// band can be used directly in dot products
+class S21BandMatrix {
+  friend class S21BandCholesky;
+  friend class S21BandLU;
+
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  S21BandMatrix() noexcept;
+  S21BandMatrix(int size, int lower, int upper);
+  S21BandMatrix(const S21Matrix& matrix, int lower, int upper);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  int GetLower() const noexcept;
+  int GetUpper() const noexcept;
+
+  /* ============================== Functions =============================== */
+  S21Vector MulVector(const S21Vector& vector) const;
+  S21Vector SolveTridiagonal(const S21Vector& rhs) const;
+  S21Vector SolveTridiagonalParallel(const S21Vector& rhs) const;
+  S21Matrix ToMatrix() const;
+
+  /* ============================== Operators =============================== */
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  int size_, lower_, upper_;
+  std::vector<double> band_;
+
+  /* ============================== Methods ================================= */
+  int Width() const noexcept;
+  void CheckIfIndexExists(int row, int col) const;
+  void CheckTridiagonal(const S21Vector& rhs) const;
+};
+
+// LU factorization of a band matrix with partial pivoting. Row swaps widen the
+// upper band of U to kl + ku, so every row keeps columns i - kl .. i + kl + ku;
+// the multipliers of L stay in the lower part of the rows
+class S21BandLU {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21BandLU(const S21BandMatrix& matrix);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  bool IsSingular() const noexcept;
+
+  /* ============================== Functions =============================== */
+  S21Vector Solve(const S21Vector& rhs) const;
+  double LogAbsDeterminant() const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  int size_, lower_, upper_;
+  std::vector<double> lu_;
+  std::vector<int> pivots_;
+  bool singular_;
+
+  /* ============================== Methods ================================= */
+  int Width() const noexcept;
+  double& At(int row, int col) noexcept;
+  const double& At(int row, int col) const noexcept;
+  void Factorize();
+};
+
+// Cholesky factorization A = L * L^T of a symmetric positive-definite band
+// matrix, only the lower band of the matrix is read. L has the lower bandwidth
+// of the matrix. As with S21Cholesky, a matrix that isn't positive-definite is
+// reported by IsPositiveDefinite() instead of throwing
+class S21BandCholesky {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21BandCholesky(const S21BandMatrix& matrix);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  bool IsPositiveDefinite() const noexcept;
+
+  /* ============================== Functions =============================== */
+  S21Vector Solve(const S21Vector& rhs) const;
+  double LogDeterminant() const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  int size_, lower_;
+  std::vector<double> factor_;
+  bool positive_definite_;
+
+  /* ============================== Methods ================================= */
+  void Factorize();
+  void CheckUsable(const S21Vector& rhs) const;
+};
+
+#endif  // S21_BAND_H
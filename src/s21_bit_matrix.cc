@@ -0,0 +1,217 @@
+#include "s21_bit_matrix.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "s21_thread_pool.h"
+
+// Bits in one word of a row
+static constexpr int kWordBits = 64;
+// Words of a row of the product updated by one tile, 4096 columns of C and
+// of every row of B it reads stay in L1
+static constexpr int kColumnWords = 64;
+// Words of a row of A consumed by one tile, the 512 rows of B they select
+// stay in L2 while every row of A passes over them
+static constexpr int kDepthWords = 8;
+// Products with fewer word operations than this run on one thread
+static constexpr long long kParallelWords = 1LL << 16;
+// Rows given to one thread by the product and the closure
+static constexpr int kRowGrain = 16;
+
+// Default constructor
+S21BitMatrix::S21BitMatrix() noexcept : rows_{}, cols_{}, stride_{} {}
+
+// Parameterized constructor, every bit is false
+S21BitMatrix::S21BitMatrix(int rows, int cols) {
+  if (rows < 1 || cols < 1) {
+    throw std::invalid_argument("Rows or columns can't be less than 1");
+  }
+  rows_ = rows;
+  cols_ = cols;
+  stride_ = (cols + kWordBits - 1) / kWordBits;
+  words_.assign(static_cast<size_t>(rows_) * stride_, 0);
+}
+
+// Packs a matrix, nonzero elements become true
+S21BitMatrix::S21BitMatrix(const S21Matrix &matrix) : S21BitMatrix() {
+  if (matrix.rows_ < 1) return;
+  *this = S21BitMatrix(matrix.rows_, matrix.cols_);
+  for (int i = 0; i < rows_; i++) {
+    std::uint64_t *row = Row(i);
+    for (int j = 0; j < cols_; j++) {
+      if (matrix.matrix_[i][j] != 0) {
+        row[j / kWordBits] |= std::uint64_t{1} << (j % kWordBits);
+      }
+    }
+  }
+}
+
+// Getter for rows
+int S21BitMatrix::GetRows() const noexcept { return rows_; }
+
+// Getter for columns
+int S21BitMatrix::GetCols() const noexcept { return cols_; }
+
+// Returns the bit in the given row and column
+bool S21BitMatrix::Get(int row, int col) const {
+  CheckIfIndexExists(row, col);
+  return (Row(row)[col / kWordBits] >> (col % kWordBits)) & 1;
+}
+
+// Sets the bit in the given row and column
+void S21BitMatrix::Set(int row, int col, bool value) {
+  CheckIfIndexExists(row, col);
+  const std::uint64_t mask = std::uint64_t{1} << (col % kWordBits);
+  if (value) {
+    Row(row)[col / kWordBits] |= mask;
+  } else {
+    Row(row)[col / kWordBits] &= ~mask;
+  }
+}
+
+// Checks if the matrices have equal sizes and bits, the unused bits are zero
+// in both, so whole words are compared
+bool S21BitMatrix::EqMatrix(const S21BitMatrix &other) const noexcept {
+  return rows_ == other.rows_ && cols_ == other.cols_ &&
+         words_ == other.words_;
+}
+
+// Adds the given matrix in the boolean semiring: bits are or-ed
+void S21BitMatrix::SumMatrix(const S21BitMatrix &other) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Rows or columns are not equal");
+  }
+  for (size_t i = 0; i < words_.size(); i++) {
+    words_[i] |= other.words_[i];
+  }
+}
+
+// Multiplies the matrix by the given one in the (or, and) semiring. Row i of
+// the product is the union of the rows of other selected by the set bits of
+// row i, found word by word with count-trailing-zeros. The product is tiled
+// like the numeric kernel and its rows are split between threads
+void S21BitMatrix::MulMatrix(const S21BitMatrix &other) {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+  }
+  if (rows_ < 1) return;
+  S21BitMatrix result(rows_, other.cols_);
+  const long long work = static_cast<long long>(rows_) * cols_ * other.stride_;
+  S21ThreadPool::Instance().ParallelFor(
+      0, rows_, work < kParallelWords ? rows_ : kRowGrain,
+      [this, &other, &result](int begin, int end) {
+        for (int jc = 0; jc < other.stride_; jc += kColumnWords) {
+          const int width = std::min(kColumnWords, other.stride_ - jc);
+          for (int pc = 0; pc < stride_; pc += kDepthWords) {
+            const int depth = std::min(kDepthWords, stride_ - pc);
+            for (int i = begin; i < end; i++) {
+              const std::uint64_t *a = Row(i);
+              std::uint64_t *c = result.Row(i) + jc;
+              for (int w = pc; w < pc + depth; w++) {
+                for (std::uint64_t bits = a[w]; bits; bits &= bits - 1) {
+                  const std::uint64_t *b =
+                      other.Row(w * kWordBits + __builtin_ctzll(bits)) + jc;
+                  for (int j = 0; j < width; j++) {
+                    c[j] |= b[j];
+                  }
+                }
+              }
+            }
+          }
+        }
+      });
+  *this = std::move(result);
+}
+
+// Returns the reachability matrix: bit (i, j) is set when j can be reached
+// from i by one or more steps. Warshall's algorithm ors row k into every row
+// that reaches k, n^3 / 64 word operations in total
+S21BitMatrix S21BitMatrix::TransitiveClosure() const {
+  if (rows_ != cols_) {
+    throw std::logic_error("The matrix is not square");
+  }
+  S21BitMatrix closure(*this);
+  const int n = rows_, stride = stride_;
+  const long long work = static_cast<long long>(n) * stride;
+  for (int k = 0; k < n; k++) {
+    const std::uint64_t *pivot = closure.Row(k);
+    const int word = k / kWordBits;
+    const std::uint64_t mask = std::uint64_t{1} << (k % kWordBits);
+    S21ThreadPool::Instance().ParallelFor(
+        0, n, work < kParallelWords ? n : kRowGrain,
+        [&closure, pivot, word, mask, stride, k](int begin, int end) {
+          for (int i = begin; i < end; i++) {
+            std::uint64_t *row = closure.Row(i);
+            if (i == k || !(row[word] & mask)) continue;
+            for (int j = 0; j < stride; j++) {
+              row[j] |= pivot[j];
+            }
+          }
+        });
+  }
+  return closure;
+}
+
+// Returns the number of set bits
+long long S21BitMatrix::Count() const noexcept {
+  long long count = 0;
+  for (std::uint64_t word : words_) {
+    count += __builtin_popcountll(word);
+  }
+  return count;
+}
+
+// Returns the matrix with 1 for set bits and 0 for the others
+S21Matrix S21BitMatrix::ToMatrix() const {
+  if (rows_ < 1) return S21Matrix();
+  S21Matrix result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    const std::uint64_t *row = Row(i);
+    for (int j = 0; j < cols_; j++) {
+      result.matrix_[i][j] = (row[j / kWordBits] >> (j % kWordBits)) & 1;
+    }
+  }
+  return result;
+}
+
+// Returns the sum of the matrices in the boolean semiring
+S21BitMatrix S21BitMatrix::operator+(const S21BitMatrix &other) const {
+  S21BitMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+// Returns the product of the matrices in the boolean semiring
+S21BitMatrix S21BitMatrix::operator*(const S21BitMatrix &other) const {
+  S21BitMatrix result(*this);
+  result.MulMatrix(other);
+  return result;
+}
+
+// Checks if the matrices are equal
+bool S21BitMatrix::operator==(const S21BitMatrix &other) const noexcept {
+  return EqMatrix(other);
+}
+
+// Returns the words of the given row
+std::uint64_t *S21BitMatrix::Row(int row) noexcept {
+  return words_.data() + static_cast<size_t>(row) * stride_;
+}
+
+// Returns the words of the given row
+const std::uint64_t *S21BitMatrix::Row(int row) const noexcept {
+  return words_.data() + static_cast<size_t>(row) * stride_;
+}
+
+// Checks if the index exists
+void S21BitMatrix::CheckIfIndexExists(int row, int col) const {
+  if (row < 0) {
+    throw std::out_of_range("Row can't be less than zero");
+  } else if (col < 0) {
+    throw std::out_of_range("Column can't be less than zero");
+  } else if (row >= rows_) {
+    throw std::out_of_range("Row doesn't exist");
+  } else if (col >= cols_) {
+    throw std::out_of_range("Column doesn't exist");
+  }
+}
@@ -0,0 +1,51 @@
+#ifndef S21_BIT_MATRIX_H
+#define S21_BIT_MATRIX_H
+
+#include <cstdint>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Boolean matrix with every row packed into 64-bit words, 64 times denser
+// than S21Matrix. Products over the (or, and) semiring and the transitive
+// closure combine whole rows with word operations, 64 columns at a time
+class S21BitMatrix {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  S21BitMatrix() noexcept;
+  S21BitMatrix(int rows, int cols);
+  explicit S21BitMatrix(const S21Matrix& matrix);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  bool Get(int row, int col) const;
+  void Set(int row, int col, bool value);
+
+  /* ============================== Functions =============================== */
+  bool EqMatrix(const S21BitMatrix& other) const noexcept;
+  void SumMatrix(const S21BitMatrix& other);
+  void MulMatrix(const S21BitMatrix& other);
+  S21BitMatrix TransitiveClosure() const;
+  long long Count() const noexcept;
+  S21Matrix ToMatrix() const;
+
+  /* ============================== Operators =============================== */
+  S21BitMatrix operator+(const S21BitMatrix& other) const;
+  S21BitMatrix operator*(const S21BitMatrix& other) const;
+  bool operator==(const S21BitMatrix& other) const noexcept;
+
+ private:
+  /* ============================= Attributes =============================== */
+  int rows_, cols_;
+  // Words per row, the unused bits of the last word are always zero
+  int stride_;
+  std::vector<std::uint64_t> words_;
+
+  /* ============================== Methods ================================= */
+  std::uint64_t* Row(int row) noexcept;
+  const std::uint64_t* Row(int row) const noexcept;
+  void CheckIfIndexExists(int row, int col) const;
+};
+
+#endif  // S21_BIT_MATRIX_H
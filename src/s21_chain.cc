@@ -0,0 +1,191 @@
+#include "s21_chain.h"
+
+#include <functional>
+#include <limits>
+#include <memory>
+
+#include "s21_gemm.h"
+
+namespace {
+
+// Cells of an intermediate product with pointers to its rows
+struct Buffer {
+  std::vector<double> cells;
+  std::vector<double *> rows;
+};
+
+// Operand of one product of the chain: the rows of a factor, or of an
+// intermediate product that owns its buffer
+struct Operand {
+  const double *const *rows;
+  std::unique_ptr<Buffer> buffer;
+};
+
+// Buffers of consumed intermediates, handed out again to later products
+class BufferPool {
+ public:
+  // Returns a zeroed rows x cols buffer. The smallest released buffer that is
+  // large enough is reused, so its memory isn't allocated again
+  std::unique_ptr<Buffer> Acquire(int rows, int cols) {
+    const size_t size = static_cast<size_t>(rows) * cols;
+    auto best = free_.end();
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+      const size_t capacity = (*it)->cells.capacity();
+      if (capacity >= size &&
+          (best == free_.end() || capacity < (*best)->cells.capacity())) {
+        best = it;
+      }
+    }
+    std::unique_ptr<Buffer> buffer;
+    if (best == free_.end()) {
+      buffer = std::make_unique<Buffer>();
+    } else {
+      buffer = std::move(*best);
+      free_.erase(best);
+    }
+    buffer->cells.assign(size, 0.0);
+    buffer->rows.resize(rows);
+    for (int i = 0; i < rows; i++) {
+      buffer->rows[i] = buffer->cells.data() + static_cast<size_t>(i) * cols;
+    }
+    return buffer;
+  }
+
+  // Takes back the buffer of a consumed intermediate, factors have none
+  void Release(std::unique_ptr<Buffer> buffer) {
+    if (buffer) free_.push_back(std::move(buffer));
+  }
+
+ private:
+  std::vector<std::unique_ptr<Buffer>> free_;
+};
+
+}  // namespace
+
+// Checks that neighbouring factors can be multiplied and plans the order
+S21MatrixChain::S21MatrixChain(
+    const std::vector<S21Matrix::BlockRef> &factors) {
+  if (factors.empty()) {
+    throw std::invalid_argument("The chain has no matrices");
+  }
+  dims_.push_back(factors[0].matrix->GetRows());
+  for (const S21Matrix::BlockRef &factor : factors) {
+    if (factor.matrix->GetRows() != dims_.back() ||
+        factor.matrix->GetRows() < 1) {
+      throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+    }
+    factors_.push_back(factor.matrix);
+    dims_.push_back(factor.matrix->GetCols());
+  }
+  Plan();
+}
+
+// Returns the number of factors
+int S21MatrixChain::GetLength() const noexcept {
+  return static_cast<int>(factors_.size());
+}
+
+// Returns the floating-point operations of the product in the planned order
+double S21MatrixChain::GetOptimalFlops() const noexcept {
+  return optimal_flops_;
+}
+
+// Returns the floating-point operations of the product evaluated from left to
+// right, as a chain of operator* does
+double S21MatrixChain::GetLeftToRightFlops() const noexcept {
+  return left_to_right_flops_;
+}
+
+// Returns the floating-point operations the planned order saves
+double S21MatrixChain::GetSavedFlops() const noexcept {
+  return left_to_right_flops_ - optimal_flops_;
+}
+
+// Returns the planned order with factors named A0, A1, ...
+std::string S21MatrixChain::GetOrder() const {
+  return Order(0, GetLength() - 1);
+}
+
+// Finds the cheapest parenthesization. cost[i][j] is the least number of
+// multiplications for factors i..j: the best split k adds the products of
+// both parts and the dims_[i] x dims_[k + 1] x dims_[j + 1] multiplication
+// joining them. Costs are kept in double, the counts exceed 64-bit integers
+// for long chains of large matrices
+void S21MatrixChain::Plan() {
+  const int n = GetLength();
+  std::vector<double> cost(static_cast<size_t>(n) * n, 0.0);
+  split_.assign(static_cast<size_t>(n) * n, 0);
+  for (int length = 2; length <= n; length++) {
+    for (int first = 0; first + length <= n; first++) {
+      const int last = first + length - 1;
+      double best = std::numeric_limits<double>::infinity();
+      for (int k = first; k < last; k++) {
+        const double candidate =
+            cost[static_cast<size_t>(first) * n + k] +
+            cost[static_cast<size_t>(k + 1) * n + last] +
+            static_cast<double>(dims_[first]) * dims_[k + 1] * dims_[last + 1];
+        if (candidate < best) {
+          best = candidate;
+          split_[static_cast<size_t>(first) * n + last] = k;
+        }
+      }
+      cost[static_cast<size_t>(first) * n + last] = best;
+    }
+  }
+  optimal_flops_ = 2 * cost[n - 1];
+  left_to_right_flops_ = 0;
+  for (int k = 1; k < n; k++) {
+    left_to_right_flops_ +=
+        2.0 * dims_[0] * dims_[k] * static_cast<double>(dims_[k + 1]);
+  }
+}
+
+// Returns the last factor of the left part of the product of factors
+// first..last
+int S21MatrixChain::Split(int first, int last) const noexcept {
+  return split_[static_cast<size_t>(first) * GetLength() + last];
+}
+
+// Returns the parenthesized product of factors first..last
+std::string S21MatrixChain::Order(int first, int last) const {
+  if (first == last) {
+    return "A" + std::to_string(first);
+  }
+  const int split = Split(first, last);
+  return "(" + Order(first, split) + " * " + Order(split + 1, last) + ")";
+}
+
+// Multiplies the factors in the planned order with the blocked GEMM kernel.
+// Intermediate products live in pooled buffers that are reused once both
+// operands of a product are consumed; the final product is accumulated
+// straight into the result
+S21Matrix S21MatrixChain::Multiply() const {
+  const int n = GetLength();
+  if (n == 1) {
+    return *factors_[0];
+  }
+  BufferPool pool;
+  std::function<Operand(int, int)> evaluate = [&](int first, int last) {
+    if (first == last) {
+      return Operand{factors_[first]->matrix_, nullptr};
+    }
+    const int split = Split(first, last);
+    Operand left = evaluate(first, split);
+    Operand right = evaluate(split + 1, last);
+    std::unique_ptr<Buffer> product =
+        pool.Acquire(dims_[first], dims_[last + 1]);
+    S21Gemm(dims_[first], dims_[last + 1], dims_[split + 1], left.rows,
+            right.rows, product->rows.data());
+    pool.Release(std::move(left.buffer));
+    pool.Release(std::move(right.buffer));
+    const double *const *rows = product->rows.data();
+    return Operand{rows, std::move(product)};
+  };
+  const int split = Split(0, n - 1);
+  Operand left = evaluate(0, split);
+  Operand right = evaluate(split + 1, n - 1);
+  S21Matrix result(dims_[0], dims_[n]);
+  S21Gemm(dims_[0], dims_[n], dims_[split + 1], left.rows, right.rows,
+          result.matrix_);
+  return result;
+}
@@ -0,0 +1,44 @@
+#ifndef S21_CHAIN_H
+#define S21_CHAIN_H
+
+#include <string>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Product of a chain of matrices in the cheapest order. The parenthesization
+// is found by dynamic programming over the shapes when the chain is created;
+// the factors aren't copied, so they must stay alive and unchanged until
+// Multiply() returns
+class S21MatrixChain {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21MatrixChain(const std::vector<S21Matrix::BlockRef>& factors);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetLength() const noexcept;
+  double GetOptimalFlops() const noexcept;
+  double GetLeftToRightFlops() const noexcept;
+  double GetSavedFlops() const noexcept;
+  std::string GetOrder() const;
+
+  /* ============================== Functions =============================== */
+  S21Matrix Multiply() const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  std::vector<const S21Matrix*> factors_;
+  // Factor i is dims_[i] x dims_[i + 1]
+  std::vector<int> dims_;
+  // split_[i * n + j] is the last factor of the left part of the product of
+  // factors i..j in the cheapest order
+  std::vector<int> split_;
+  double optimal_flops_, left_to_right_flops_;
+
+  /* ============================== Methods ================================= */
+  void Plan();
+  int Split(int first, int last) const noexcept;
+  std::string Order(int first, int last) const;
+};
+
+#endif  // S21_CHAIN_H
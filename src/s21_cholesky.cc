@@ -0,0 +1,249 @@
+#include "s21_cholesky.h"
+
+#include <algorithm>
+
+#include "s21_thread_pool.h"
+
+// Number of columns factorized at once before the trailing matrix is updated
+static constexpr int kPanelWidth = 64;
+// Number of right-hand side columns solved by one task
+static constexpr int kRhsBlock = 64;
+// Minimal number of rows given to one thread
+static constexpr int kRowGrain = 32;
+
+// Factorizes the given square matrix
+S21Cholesky::S21Cholesky(const S21Matrix &matrix, Kind kind)
+    : factor_(matrix), kind_(kind), positive_definite_(false) {
+  if (matrix.rows_ != matrix.cols_) {
+    throw std::logic_error("The matrix is not square");
+  }
+  if (matrix.rows_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+  if (IsSymmetric()) {
+    factor_.Detach();
+    Factorize();
+  }
+  factor_.Touch();
+}
+
+// Returns the order of the factorized matrix
+int S21Cholesky::GetSize() const noexcept { return factor_.rows_; }
+
+// Returns the kind of the factorization
+S21Cholesky::Kind S21Cholesky::GetKind() const noexcept { return kind_; }
+
+// Checks if the matrix turned out to be symmetric positive-definite
+bool S21Cholesky::IsPositiveDefinite() const noexcept {
+  return positive_definite_;
+}
+
+// Returns the lower triangular factor, with unit diagonal for LDL^T
+S21Matrix S21Cholesky::GetL() const {
+  CheckUsable(factor_);
+  S21Matrix lower(factor_);
+  lower.Detach();
+  if (kind_ == Kind::kLDLT) {
+    for (int i = 0; i < lower.rows_; i++) {
+      lower.matrix_[i][i] = 1.0;
+    }
+  }
+  return lower;
+}
+
+// Returns the diagonal matrix D of LDL^T, identity for LL^T
+S21Matrix S21Cholesky::GetD() const {
+  CheckUsable(factor_);
+  S21Matrix diagonal(factor_.rows_, factor_.cols_);
+  for (int i = 0; i < diagonal.rows_; i++) {
+    diagonal.matrix_[i][i] =
+        kind_ == Kind::kLDLT ? factor_.matrix_[i][i] : 1.0;
+  }
+  return diagonal;
+}
+
+// Checks if the matrix is symmetric with the same accuracy as EqMatrix
+bool S21Cholesky::IsSymmetric() const noexcept {
+  for (int i = 0; i < factor_.rows_; i++) {
+    for (int j = 0; j < i; j++) {
+      if (fabs(factor_.matrix_[i][j] - factor_.matrix_[j][i]) >= 1.0e-07) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Blocked right-looking factorization reading only the lower triangle: the
+// diagonal block is factorized first, then the rows below it are solved and
+// the trailing lower triangle is updated in parallel. Every inner loop is a
+// dot product of two contiguous row segments
+void S21Cholesky::Factorize() {
+  const int n = factor_.rows_;
+  for (int from = 0; from < n; from += kPanelWidth) {
+    const int to = std::min(n, from + kPanelWidth);
+    if (!FactorizeDiagonalBlock(from, to)) return;
+    FactorizePanel(from, to);
+    UpdateTrailing(from, to);
+  }
+  for (int i = 0; i < n; i++) {
+    std::fill(factor_.matrix_[i] + i + 1, factor_.matrix_[i] + n, 0.0);
+  }
+  positive_definite_ = true;
+}
+
+// Returns the sum of row1[t] * row2[t] over t in [from, to), weighted by D for
+// LDL^T
+double S21Cholesky::WeightedDot(int row1, int row2, int from,
+                                int to) const noexcept {
+  const double *first = factor_.matrix_[row1];
+  const double *second = factor_.matrix_[row2];
+  double sum = 0;
+  if (kind_ == Kind::kLLT) {
+    for (int t = from; t < to; t++) {
+      sum += first[t] * second[t];
+    }
+  } else {
+    for (int t = from; t < to; t++) {
+      sum += first[t] * second[t] * factor_.matrix_[t][t];
+    }
+  }
+  return sum;
+}
+
+// Factorizes the diagonal block [from, to), returns false if a non-positive
+// pivot shows that the matrix is not positive-definite
+bool S21Cholesky::FactorizeDiagonalBlock(int from, int to) {
+  double **a = factor_.matrix_;
+  for (int j = from; j < to; j++) {
+    const double pivot = a[j][j] - WeightedDot(j, j, from, j);
+    if (!(pivot > 0)) return false;
+    a[j][j] = kind_ == Kind::kLLT ? sqrt(pivot) : pivot;
+    for (int i = j + 1; i < to; i++) {
+      a[i][j] = (a[i][j] - WeightedDot(i, j, from, j)) / a[j][j];
+    }
+  }
+  return true;
+}
+
+// Solves the rows below the diagonal block against it
+void S21Cholesky::FactorizePanel(int from, int to) {
+  double **a = factor_.matrix_;
+  S21ThreadPool::Instance().ParallelFor(
+      to, factor_.rows_, kRowGrain, [this, a, from, to](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          for (int j = from; j < to; j++) {
+            a[i][j] = (a[i][j] - WeightedDot(i, j, from, j)) / a[j][j];
+          }
+        }
+      });
+}
+
+// Subtracts the contribution of the panel from the trailing lower triangle
+void S21Cholesky::UpdateTrailing(int from, int to) {
+  double **a = factor_.matrix_;
+  S21ThreadPool::Instance().ParallelFor(
+      to, factor_.rows_, kRowGrain, [this, a, from, to](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          for (int j = to; j <= i; j++) {
+            a[i][j] -= WeightedDot(i, j, from, to);
+          }
+        }
+      });
+}
+
+// Checks if the factorization can be used with the right-hand side
+void S21Cholesky::CheckUsable(const S21Matrix &rhs) const {
+  if (!positive_definite_) {
+    throw std::logic_error("The matrix is not symmetric positive-definite");
+  }
+  if (rhs.rows_ != factor_.rows_) {
+    throw std::invalid_argument(
+        "Right-hand side rows are not equal to the matrix size");
+  }
+}
+
+// Solves A * X = rhs for every column of rhs and returns X
+S21Matrix S21Cholesky::Solve(const S21Matrix &rhs) const {
+  S21Matrix result(rhs);
+  SolveInPlace(result);
+  return result;
+}
+
+// Solves A * X = rhs for every column of rhs, overwriting rhs with X. Blocks of
+// right-hand side columns are solved in parallel, the backward substitution
+// with L^T reads L by rows so it stays on contiguous memory
+void S21Cholesky::SolveInPlace(S21Matrix &rhs) const {
+  CheckUsable(rhs);
+  rhs.Detach();
+  const int n = factor_.rows_;
+  const bool unit = kind_ == Kind::kLDLT;
+  double **l = factor_.matrix_;
+  double **b = rhs.matrix_;
+  const int blocks = (rhs.cols_ + kRhsBlock - 1) / kRhsBlock;
+  S21ThreadPool::Instance().ParallelFor(
+      0, blocks, 1, [l, b, n, unit, &rhs](int first, int last) {
+        const int begin = first * kRhsBlock;
+        const int end = std::min(rhs.cols_, last * kRhsBlock);
+        for (int i = 0; i < n; i++) {
+          double *target = b[i];
+          for (int t = 0; t < i; t++) {
+            const double factor = l[i][t];
+            const double *source = b[t];
+            for (int c = begin; c < end; c++) {
+              target[c] -= factor * source[c];
+            }
+          }
+          if (!unit) {
+            const double inverse = 1.0 / l[i][i];
+            for (int c = begin; c < end; c++) {
+              target[c] *= inverse;
+            }
+          }
+        }
+        for (int i = 0; unit && i < n; i++) {
+          const double inverse = 1.0 / l[i][i];
+          for (int c = begin; c < end; c++) {
+            b[i][c] *= inverse;
+          }
+        }
+        for (int t = n - 1; t >= 0; t--) {
+          double *source = b[t];
+          if (!unit) {
+            const double inverse = 1.0 / l[t][t];
+            for (int c = begin; c < end; c++) {
+              source[c] *= inverse;
+            }
+          }
+          for (int i = 0; i < t; i++) {
+            const double factor = l[t][i];
+            double *target = b[i];
+            for (int c = begin; c < end; c++) {
+              target[c] -= factor * source[c];
+            }
+          }
+        }
+      });
+  rhs.Touch();
+}
+
+// Returns the natural logarithm of the determinant, which doesn't overflow for
+// large matrices the way the determinant itself does
+double S21Cholesky::LogDeterminant() const {
+  CheckUsable(factor_);
+  double sum = 0;
+  for (int i = 0; i < factor_.rows_; i++) {
+    sum += log(factor_.matrix_[i][i]);
+  }
+  return kind_ == Kind::kLLT ? 2 * sum : sum;
+}
+
+// Returns the inverse matrix by solving against the identity
+S21Matrix S21Cholesky::Inverse() const {
+  S21Matrix inversed(factor_.rows_, factor_.cols_);
+  for (int i = 0; i < inversed.rows_; i++) {
+    inversed.matrix_[i][i] = 1.0;
+  }
+  SolveInPlace(inversed);
+  return inversed;
+}
@@ -0,0 +1,47 @@
+#ifndef S21_CHOLESKY_H
+#define S21_CHOLESKY_H
+
+#include "s21_matrix_oop.h"
+
+// Cholesky factorization of a symmetric positive-definite matrix, either
+// A = L * L^T or A = L * D * L^T with unit L. The factor is kept in the lower
+// triangle of one matrix, for LDL^T the diagonal holds D. A matrix that is not
+// symmetric positive-definite doesn't throw on factorization, it is reported by
+// IsPositiveDefinite() so the caller can fall back to LU
+class S21Cholesky {
+ public:
+  enum class Kind { kLLT, kLDLT };
+
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21Cholesky(const S21Matrix& matrix, Kind kind = Kind::kLLT);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  Kind GetKind() const noexcept;
+  bool IsPositiveDefinite() const noexcept;
+  S21Matrix GetL() const;
+  S21Matrix GetD() const;
+
+  /* ============================== Functions =============================== */
+  S21Matrix Solve(const S21Matrix& rhs) const;
+  void SolveInPlace(S21Matrix& rhs) const;
+  double LogDeterminant() const;
+  S21Matrix Inverse() const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  S21Matrix factor_;
+  Kind kind_;
+  bool positive_definite_;
+
+  /* ============================== Methods ================================= */
+  bool IsSymmetric() const noexcept;
+  void Factorize();
+  bool FactorizeDiagonalBlock(int from, int to);
+  void FactorizePanel(int from, int to);
+  void UpdateTrailing(int from, int to);
+  double WeightedDot(int row1, int row2, int from, int to) const noexcept;
+  void CheckUsable(const S21Matrix& rhs) const;
+};
+
+#endif  // S21_CHOLESKY_H
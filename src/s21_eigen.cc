@@ -0,0 +1,409 @@
+#include "s21_eigen.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+#include "s21_gemm.h"
+#include "s21_thread_pool.h"
+
+// Minimal number of rows given to one thread
+static constexpr int kRowGrain = 64;
+// Reflectors of one panel of the tridiagonal reduction, the trailing block is
+// updated once per panel by a product with an inner dimension of kPanel
+static constexpr int kPanel = 32;
+// Minimal number of eigenvector columns given to one thread by a QL sweep
+static constexpr int kColumnGrain = 128;
+// QL sweeps touching fewer cells than this rotate on one thread
+static constexpr long long kParallelRotations = 1LL << 15;
+// Maximal number of QL iterations spent on one eigenvalue
+static constexpr int kMaxIterations = 60;
+
+// Decomposes the given symmetric matrix, the eigenvectors are skipped if not
+// needed, which saves the accumulation of the reflectors and rotations
+S21SymmetricEigen::S21SymmetricEigen(const S21Matrix &matrix, bool vectors) {
+  CheckSymmetric(matrix);
+  const int n = matrix.rows_;
+  S21Matrix work(matrix);
+  work.Detach();
+  std::vector<double> off, tau;
+  Tridiagonalize(work, values_, off, tau);
+  if (vectors) {
+    vectors_ = S21Matrix(n, n);
+    for (int i = 0; i < n; i++) {
+      vectors_.matrix_[i][i] = 1.0;
+    }
+    AccumulateQ(work, tau, vectors_);
+  }
+  DiagonalizeQL(values_, off, vectors ? &vectors_ : nullptr);
+
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [this](int i, int j) { return values_[i] < values_[j]; });
+  std::vector<double> sorted(n);
+  for (int i = 0; i < n; i++) {
+    sorted[i] = values_[order[i]];
+  }
+  values_.swap(sorted);
+  if (vectors) {
+    S21Matrix rows(n, n);
+    for (int i = 0; i < n; i++) {
+      std::copy(vectors_.matrix_[order[i]], vectors_.matrix_[order[i]] + n,
+                rows.matrix_[i]);
+    }
+    vectors_ = std::move(rows);
+  }
+}
+
+// Returns the order of the decomposed matrix
+int S21SymmetricEigen::GetSize() const noexcept {
+  return static_cast<int>(values_.size());
+}
+
+// Checks if the eigenvectors were computed
+bool S21SymmetricEigen::HasVectors() const noexcept {
+  return vectors_.rows_ > 0;
+}
+
+// Returns the eigenvalues in ascending order
+const std::vector<double> &S21SymmetricEigen::GetValues() const noexcept {
+  return values_;
+}
+
+// Returns the matrix whose columns are the eigenvectors
+S21Matrix S21SymmetricEigen::GetVectors() const {
+  if (!HasVectors()) {
+    throw std::logic_error("Eigenvectors were not computed");
+  }
+  return vectors_.Transpose();
+}
+
+// Checks if the matrix is square, not empty and symmetric with the same
+// accuracy as EqMatrix
+void S21SymmetricEigen::CheckSymmetric(const S21Matrix &matrix) {
+  if (matrix.rows_ != matrix.cols_) {
+    throw std::logic_error("The matrix is not square");
+  }
+  if (matrix.rows_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+  for (int i = 0; i < matrix.rows_; i++) {
+    for (int j = 0; j < i; j++) {
+      if (fabs(matrix.matrix_[i][j] - matrix.matrix_[j][i]) >= 1.0e-07) {
+        throw std::logic_error("The matrix is not symmetric");
+      }
+    }
+  }
+}
+
+// Reduces the matrix to tridiagonal form T = Q^T * A * Q in panels of kPanel
+// reflectors. Within a panel the trailing block is not updated: reflector j
+// is taken from row j brought up to date with the panel's earlier vectors,
+// and A * v is corrected by -V * (W^T * v) - W * (V^T * v), so every step is
+// one pass of A * v split between threads by rows. After the panel the
+// trailing block gets the rank-2 * kPanel update B -= V * W^T + W * V^T on
+// the blocked GEMM kernel. The reflector tails are left in row j of work for
+// AccumulateQ
+void S21SymmetricEigen::Tridiagonalize(S21Matrix &work,
+                                       std::vector<double> &diagonal,
+                                       std::vector<double> &off,
+                                       std::vector<double> &tau) {
+  const int n = work.rows_;
+  double **a = work.matrix_;
+  diagonal.assign(n, 0.0);
+  off.assign(n, 0.0);
+  tau.assign(n, 0.0);
+  if (n < 3) {
+    if (n == 2) off[0] = a[0][1];
+    for (int i = 0; i < n; i++) diagonal[i] = a[i][i];
+    return;
+  }
+  S21Matrix panel_v(n, kPanel), panel_w(n, kPanel);
+  double **pv = panel_v.matrix_, **pw = panel_w.matrix_;
+  std::vector<double> v(n), x(kPanel), y(kPanel);
+  std::vector<double *> trailing(n);
+  for (int from = 0; from + 2 < n; from += kPanel) {
+    const int width = std::min(kPanel, n - 2 - from);
+    for (int c = 0; c < width; c++) {
+      const int k = from + c;
+      // Row k of A - V * W^T - W * V^T for the panel's earlier reflectors
+      for (int t = 0; t < c; t++) {
+        const double vk = pv[k][t], wk = pw[k][t];
+        for (int j = k; j < n; j++) {
+          a[k][j] -= pv[j][t] * wk + pw[j][t] * vk;
+        }
+      }
+      diagonal[k] = a[k][k];
+      const double alpha = a[k][k + 1];
+      double tail = 0;
+      for (int j = k + 2; j < n; j++) {
+        tail += a[k][j] * a[k][j];
+      }
+      if (tail == 0) {
+        off[k] = alpha;
+        for (int i = k + 1; i < n; i++) pv[i][c] = pw[i][c] = 0;
+        continue;
+      }
+      const double beta = alpha >= 0 ? -sqrt(alpha * alpha + tail)
+                                     : sqrt(alpha * alpha + tail);
+      tau[k] = (beta - alpha) / beta;
+      const double scale = 1.0 / (alpha - beta);
+      v[k + 1] = 1.0;
+      for (int j = k + 2; j < n; j++) {
+        a[k][j] *= scale;
+        v[j] = a[k][j];
+      }
+      off[k] = beta;
+      for (int t = 0; t < c; t++) {
+        double wv = 0, vv = 0;
+        for (int i = k + 1; i < n; i++) {
+          wv += pw[i][t] * v[i];
+          vv += pv[i][t] * v[i];
+        }
+        x[t] = wv;
+        y[t] = vv;
+      }
+      const double t = tau[k];
+      S21ThreadPool::Instance().ParallelFor(
+          k + 1, n, kRowGrain,
+          [a, pv, pw, &v, &x, &y, c, k, n, t](int begin, int end) {
+            for (int i = begin; i < end; i++) {
+              double sum = 0;
+              for (int j = k + 1; j < n; j++) {
+                sum += a[i][j] * v[j];
+              }
+              for (int p = 0; p < c; p++) {
+                sum -= pv[i][p] * x[p] + pw[i][p] * y[p];
+              }
+              pw[i][c] = t * sum;
+            }
+          });
+      double dot = 0;
+      for (int i = k + 1; i < n; i++) {
+        dot += pw[i][c] * v[i];
+      }
+      const double shift = 0.5 * t * dot;
+      for (int i = k + 1; i < n; i++) {
+        pw[i][c] -= shift * v[i];
+        pv[i][c] = v[i];
+      }
+    }
+    // B -= V * W^T + W * V^T on the rows and columns after the panel
+    const int first = from + width, size = n - first;
+    for (int i = first; i < n; i++) {
+      trailing[i] = a[i] + first;
+    }
+    S21GemmNT(size, size, width, pv + first, pw + first,
+              trailing.data() + first, -1.0);
+    S21GemmNT(size, size, width, pw + first, pv + first,
+              trailing.data() + first, -1.0);
+  }
+  diagonal[n - 2] = a[n - 2][n - 2];
+  off[n - 2] = a[n - 2][n - 1];
+  diagonal[n - 1] = a[n - 1][n - 1];
+}
+
+// Overwrites rows (the identity) with Q^T = H_{n-3} * ... * H_0. The
+// reflectors of a panel are combined into the block reflector
+// H_{k+b-1} * ... * H_k = I - V * T^T * V^T with an upper triangular T, so
+// each panel is applied to all rows at once by three GEMM calls
+void S21SymmetricEigen::AccumulateQ(const S21Matrix &work,
+                                    const std::vector<double> &tau,
+                                    S21Matrix &rows) {
+  const int n = work.rows_;
+  if (n < 3) return;
+  double **a = work.matrix_;
+  double **q = rows.matrix_;
+  S21Matrix panel_v(n, kPanel), factor(kPanel, kPanel);
+  S21Matrix product(kPanel, n), scaled(kPanel, n);
+  double **pv = panel_v.matrix_, **pt = factor.matrix_;
+  std::vector<double> dots(kPanel);
+  for (int from = 0; from + 2 < n; from += kPanel) {
+    const int width = std::min(kPanel, n - 2 - from);
+    const int first = from + 1, size = n - first;
+    for (int i = first; i < n; i++) {
+      for (int c = 0; c < width; c++) {
+        const int k = from + c;
+        pv[i][c] = tau[k] == 0 || i <= k ? 0 : i == k + 1 ? 1 : a[k][i];
+      }
+    }
+    // T(0:c, c) = -tau_c * T(0:c, 0:c) * V(:, 0:c)^T * v_c
+    for (int c = 0; c < width; c++) {
+      for (int p = 0; p < c; p++) {
+        double dot = 0;
+        for (int i = from + c + 1; i < n; i++) {
+          dot += pv[i][p] * pv[i][c];
+        }
+        dots[p] = dot;
+      }
+      const double t = tau[from + c];
+      for (int r = 0; r < c; r++) {
+        double sum = 0;
+        for (int p = r; p < c; p++) {
+          sum += pt[r][p] * dots[p];
+        }
+        pt[r][c] = -t * sum;
+      }
+      pt[c][c] = t;
+      for (int r = c + 1; r < kPanel; r++) pt[r][c] = 0;
+    }
+    // Q -= V * (T^T * (V^T * Q)) on the rows touched by the panel
+    for (int r = 0; r < width; r++) {
+      std::fill(product.matrix_[r], product.matrix_[r] + n, 0.0);
+      std::fill(scaled.matrix_[r], scaled.matrix_[r] + n, 0.0);
+    }
+    S21GemmTN(width, n, size, pv + first, q + first, product.matrix_, 1.0);
+    S21GemmTN(width, n, width, pt, product.matrix_, scaled.matrix_, 1.0);
+    S21Gemm(size, n, width, pv + first, scaled.matrix_, q + first, -1.0);
+  }
+}
+
+// Implicit QL with Wilkinson shifts on the tridiagonal matrix given by its
+// diagonal and off-diagonal (off[i] couples i and i + 1). The rotations of a
+// sweep are recorded and applied to the rows of the eigenvector matrix, when
+// it is given, after the sweep
+void S21SymmetricEigen::DiagonalizeQL(std::vector<double> &diagonal,
+                                      std::vector<double> &off,
+                                      S21Matrix *rows) {
+  const int n = static_cast<int>(diagonal.size());
+  std::vector<double> &d = diagonal;
+  std::vector<double> &e = off;
+  e[n - 1] = 0;
+  std::vector<double> cosines(n), sines(n);
+  double shift_sum = 0, largest = 0;
+  for (int l = 0; l < n; l++) {
+    largest = std::max(largest, fabs(d[l]) + fabs(e[l]));
+    int m = l;
+    while (m < n - 1 && fabs(e[m]) > DBL_EPSILON * largest) m++;
+    if (m > l) {
+      int iterations = 0;
+      do {
+        if (++iterations > kMaxIterations) {
+          throw std::runtime_error("Eigenvalues did not converge");
+        }
+        double g = d[l];
+        double p = (d[l + 1] - g) / (2.0 * e[l]);
+        double r = hypot(p, 1.0);
+        if (p < 0) r = -r;
+        d[l] = e[l] / (p + r);
+        d[l + 1] = e[l] * (p + r);
+        const double next = d[l + 1];
+        double h = g - d[l];
+        for (int i = l + 2; i < n; i++) {
+          d[i] -= h;
+        }
+        shift_sum += h;
+
+        p = d[m];
+        double c = 1, c2 = 1, c3 = 1, s = 0, s2 = 0;
+        const double el1 = e[l + 1];
+        for (int i = m - 1; i >= l; i--) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c * e[i];
+          h = c * p;
+          r = hypot(p, e[i]);
+          e[i + 1] = s * r;
+          s = e[i] / r;
+          c = p / r;
+          p = c * d[i] - s * g;
+          d[i + 1] = h + s * (c * g + s * d[i]);
+          cosines[i] = c;
+          sines[i] = s;
+        }
+        if (rows) RotateRows(*rows, cosines, sines, l, m);
+        p = -s * s2 * c3 * el1 * e[l] / next;
+        e[l] = s * p;
+        d[l] = c * p;
+      } while (fabs(e[l]) > DBL_EPSILON * largest);
+    }
+    d[l] += shift_sum;
+    e[l] = 0;
+  }
+}
+
+// Applies the rotations of one QL sweep, i = last - 1 down to first, to rows
+// i and i + 1. Every column is rotated independently, so slabs of columns run
+// in parallel and the sweep reads each slab of the two rows from cache
+void S21SymmetricEigen::RotateRows(S21Matrix &rows,
+                                   const std::vector<double> &cosines,
+                                   const std::vector<double> &sines,
+                                   int first, int last) {
+  const int n = rows.cols_;
+  double **q = rows.matrix_;
+  const long long work = static_cast<long long>(last - first) * n;
+  S21ThreadPool::Instance().ParallelFor(
+      0, n, work < kParallelRotations ? n : kColumnGrain,
+      [q, &cosines, &sines, first, last](int begin, int end) {
+        for (int i = last - 1; i >= first; i--) {
+          const double c = cosines[i], s = sines[i];
+          double *upper = q[i], *lower = q[i + 1];
+          for (int k = begin; k < end; k++) {
+            const double h = lower[k];
+            lower[k] = s * upper[k] + c * h;
+            upper[k] = c * upper[k] - s * h;
+          }
+        }
+      });
+}
+
+// Returns the number of eigenvalues of the tridiagonal matrix that are less
+// than bound (Sturm sequence count)
+int S21SymmetricEigen::CountBelow(const std::vector<double> &diagonal,
+                                  const std::vector<double> &off,
+                                  double bound) noexcept {
+  int count = 0;
+  double q = 1;
+  for (size_t i = 0; i < diagonal.size(); i++) {
+    const double coupling = i > 0 ? off[i - 1] * off[i - 1] : 0.0;
+    q = diagonal[i] - bound - (i > 0 ? coupling / q : 0.0);
+    if (q == 0) q = -DBL_MIN;
+    if (q < 0) count++;
+  }
+  return count;
+}
+
+// Returns the eigenvalues with ascending indices [first, last] of a symmetric
+// matrix. Only the tridiagonal reduction is done, then every requested value
+// is isolated by bisection, so a few values cost much less than all of them
+std::vector<double> S21SymmetricEigen::Values(const S21Matrix &matrix,
+                                              int first, int last) {
+  CheckSymmetric(matrix);
+  const int n = matrix.rows_;
+  if (first < 0 || last >= n || first > last) {
+    throw std::out_of_range("Invalid range of eigenvalue indices");
+  }
+  S21Matrix work(matrix);
+  work.Detach();
+  std::vector<double> diagonal, off, tau;
+  Tridiagonalize(work, diagonal, off, tau);
+  double low = diagonal[0], high = diagonal[0];
+  for (int i = 0; i < n; i++) {
+    const double radius =
+        (i > 0 ? fabs(off[i - 1]) : 0.0) + (i + 1 < n ? fabs(off[i]) : 0.0);
+    low = std::min(low, diagonal[i] - radius);
+    high = std::max(high, diagonal[i] + radius);
+  }
+  const double tolerance =
+      2 * DBL_EPSILON * std::max(fabs(low), fabs(high)) + DBL_MIN;
+  std::vector<double> values(last - first + 1);
+  S21ThreadPool::Instance().ParallelFor(
+      first, last + 1, 1, [&](int begin, int end) {
+        for (int index = begin; index < end; index++) {
+          double left = low, right = high;
+          while (right - left > tolerance) {
+            const double middle = 0.5 * (left + right);
+            if (middle == left || middle == right) break;
+            if (CountBelow(diagonal, off, middle) > index) {
+              right = middle;
+            } else {
+              left = middle;
+            }
+          }
+          values[index - first] = 0.5 * (left + right);
+        }
+      });
+  return values;
+}
@@ -0,0 +1,51 @@
+#ifndef S21_EIGEN_H
+#define S21_EIGEN_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Eigen decomposition A = V * diag(values) * V^T of a symmetric matrix. The
+// matrix is reduced to tridiagonal form with panels of Householder reflectors
+// applied through GEMM and the tridiagonal matrix is diagonalized with the
+// implicit QL algorithm, whose rotations update slabs of eigenvector columns
+// in parallel. Values are sorted in ascending order, column i of V belongs to
+// value i
+class S21SymmetricEigen {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21SymmetricEigen(const S21Matrix& matrix, bool vectors = true);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  bool HasVectors() const noexcept;
+  const std::vector<double>& GetValues() const noexcept;
+  S21Matrix GetVectors() const;
+
+  /* ============================== Functions =============================== */
+  static std::vector<double> Values(const S21Matrix& matrix, int first,
+                                    int last);
+
+ private:
+  /* ============================= Attributes =============================== */
+  std::vector<double> values_;
+  // Eigenvectors stored as rows, so QL rotations combine contiguous rows
+  S21Matrix vectors_;
+
+  /* ============================== Methods ================================= */
+  static void Tridiagonalize(S21Matrix& work, std::vector<double>& diagonal,
+                             std::vector<double>& off,
+                             std::vector<double>& tau);
+  static void AccumulateQ(const S21Matrix& work, const std::vector<double>& tau,
+                          S21Matrix& rows);
+  static void DiagonalizeQL(std::vector<double>& diagonal,
+                            std::vector<double>& off, S21Matrix* rows);
+  static void RotateRows(S21Matrix& rows, const std::vector<double>& cosines,
+                         const std::vector<double>& sines, int first,
+                         int last);
+  static int CountBelow(const std::vector<double>& diagonal,
+                        const std::vector<double>& off, double bound) noexcept;
+  static void CheckSymmetric(const S21Matrix& matrix);
+};
+
+#endif  // S21_EIGEN_H
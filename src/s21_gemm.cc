@@ -0,0 +1,175 @@
+#include "s21_gemm.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "s21_thread_pool.h"
+
+// Columns of B and C handled by one tile, a tile row of C stays in L1
+static constexpr int kColumnBlock = 256;
+// Rows of B handled by one tile, the kDepthBlock x kColumnBlock tile of B
+// stays in L2 while every row of A passes over it
+static constexpr int kDepthBlock = 128;
+// Rows of C updated together, so each loaded element of B is used that often
+static constexpr int kRowBlock = 4;
+// Products smaller than this number of multiplications run on one thread
+static constexpr long long kParallelWork = 64LL * 64 * 64;
+
+// Rows of B in the transposed kernel reused by every row of A, a
+// kDotBlock x kDepthBlock tile of B stays in L2
+static constexpr int kDotBlock = 64;
+
+// Accumulates rows [begin, end) of C += alpha * A * B tile by tile, with the
+// addition and multiplication of the semiring. With kTransposedA the rows of C
+// come from the columns of A, the elements a row block needs at one depth are
+// then adjacent
+template <typename Semiring, bool kTransposedA>
+static void GemmRows(int begin, int end, int n, int k, double alpha,
+                     const double *const *a, const double *const *b,
+                     double **c) {
+  // The numeric product is spelled out, so it stays fast without inlining
+  constexpr bool kNumeric = std::is_same_v<Semiring, S21PlusTimes>;
+  const auto at = [a, alpha](int i, int p) {
+    return Semiring::Times(alpha, kTransposedA ? a[p][i] : a[i][p]);
+  };
+  for (int jc = 0; jc < n; jc += kColumnBlock) {
+    const int width = std::min(kColumnBlock, n - jc);
+    for (int pc = 0; pc < k; pc += kDepthBlock) {
+      const int depth = std::min(kDepthBlock, k - pc);
+      int i = begin;
+      for (; i + kRowBlock <= end; i += kRowBlock) {
+        double *c0 = c[i] + jc, *c1 = c[i + 1] + jc;
+        double *c2 = c[i + 2] + jc, *c3 = c[i + 3] + jc;
+        for (int p = pc; p < pc + depth; p++) {
+          const double a0 = at(i, p), a1 = at(i + 1, p);
+          const double a2 = at(i + 2, p), a3 = at(i + 3, p);
+          const double *row = b[p] + jc;
+          for (int j = 0; j < width; j++) {
+            const double value = row[j];
+            if constexpr (kNumeric) {
+              c0[j] += a0 * value;
+              c1[j] += a1 * value;
+              c2[j] += a2 * value;
+              c3[j] += a3 * value;
+            } else {
+              c0[j] = Semiring::Plus(c0[j], Semiring::Times(a0, value));
+              c1[j] = Semiring::Plus(c1[j], Semiring::Times(a1, value));
+              c2[j] = Semiring::Plus(c2[j], Semiring::Times(a2, value));
+              c3[j] = Semiring::Plus(c3[j], Semiring::Times(a3, value));
+            }
+          }
+        }
+      }
+      for (; i < end; i++) {
+        double *target = c[i] + jc;
+        for (int p = pc; p < pc + depth; p++) {
+          const double factor = at(i, p);
+          const double *row = b[p] + jc;
+          for (int j = 0; j < width; j++) {
+            if constexpr (kNumeric) {
+              target[j] += factor * row[j];
+            } else {
+              target[j] =
+                  Semiring::Plus(target[j], Semiring::Times(factor, row[j]));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Accumulates rows [begin, end) of C += alpha * A * B^T, every element is the
+// dot product of a row of A and a row of B, both contiguous
+static void GemmRowsTransposedB(int begin, int end, int n, int k, double alpha,
+                                const double *const *a,
+                                const double *const *b, double **c) {
+  for (int jc = 0; jc < n; jc += kDotBlock) {
+    const int width = std::min(kDotBlock, n - jc);
+    for (int pc = 0; pc < k; pc += kDepthBlock) {
+      const int depth = std::min(kDepthBlock, k - pc);
+      for (int i = begin; i < end; i++) {
+        const double *row = a[i] + pc;
+        double *target = c[i] + jc;
+        for (int j = 0; j < width; j++) {
+          target[j] += alpha * S21Dot(row, b[jc + j] + pc, depth);
+        }
+      }
+    }
+  }
+}
+
+// Splits the rows of C between threads when the product is large enough,
+// every thread walks the tiles of B on its own
+template <typename Rows>
+static void GemmParallel(int m, int n, int k, Rows rows) {
+  if (m < 1 || n < 1 || k < 1) return;
+  const long long work = static_cast<long long>(m) * n * k;
+  const int grain = work < kParallelWork ? m : kRowBlock * 4;
+  S21ThreadPool::Instance().ParallelFor(0, m, grain, rows);
+}
+
+// C += alpha * A * B
+void S21Gemm(int m, int n, int k, const double *const *a,
+             const double *const *b, double **c, double alpha) {
+  GemmParallel(m, n, k, [=](int begin, int end) {
+    GemmRows<S21PlusTimes, false>(begin, end, n, k, alpha, a, b, c);
+  });
+}
+
+// C += alpha * A^T * B
+void S21GemmTN(int m, int n, int k, const double *const *a,
+               const double *const *b, double **c, double alpha) {
+  GemmParallel(m, n, k, [=](int begin, int end) {
+    GemmRows<S21PlusTimes, true>(begin, end, n, k, alpha, a, b, c);
+  });
+}
+
+// C += alpha * A * B^T
+void S21GemmNT(int m, int n, int k, const double *const *a,
+               const double *const *b, double **c, double alpha) {
+  GemmParallel(m, n, k, [=](int begin, int end) {
+    GemmRowsTransposedB(begin, end, n, k, alpha, a, b, c);
+  });
+}
+
+// C = C (+) A (*) B in the semiring, on the tiles of the numeric kernel
+template <typename Semiring>
+void S21SemiringGemm(int m, int n, int k, const double *const *a,
+                     const double *const *b, double **c) {
+  GemmParallel(m, n, k, [=](int begin, int end) {
+    GemmRows<Semiring, false>(begin, end, n, k, Semiring::kOne, a, b, c);
+  });
+}
+
+template void S21SemiringGemm<S21PlusTimes>(int, int, int,
+                                            const double *const *,
+                                            const double *const *, double **);
+template void S21SemiringGemm<S21MinPlus>(int, int, int, const double *const *,
+                                          const double *const *, double **);
+template void S21SemiringGemm<S21MaxPlus>(int, int, int, const double *const *,
+                                          const double *const *, double **);
+
+// Four independent partial sums break the dependency chain of the additions,
+// so the loop can be pipelined and vectorized without reassociation flags
+double S21Dot(const double *x, const double *y, int size) noexcept {
+  double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    sum0 += x[i] * y[i];
+    sum1 += x[i + 1] * y[i + 1];
+    sum2 += x[i + 2] * y[i + 2];
+    sum3 += x[i + 3] * y[i + 3];
+  }
+  for (; i < size; i++) {
+    sum0 += x[i] * y[i];
+  }
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+// Adds alpha * x to y element by element
+void S21Axpy(double alpha, const double *x, double *y, int size) noexcept {
+  for (int i = 0; i < size; i++) {
+    y[i] += alpha * x[i];
+  }
+}
@@ -0,0 +1,58 @@
+#ifndef S21_GEMM_H
+#define S21_GEMM_H
+
+#include <limits>
+
+// Blocked and multithreaded product kernel shared by the matrix operations.
+// Matrices are given by their row pointers, c (m x n) accumulates the scaled
+// product of a (m x k) and b (k x n): C += alpha * A * B
+void S21Gemm(int m, int n, int k, const double* const* a,
+             const double* const* b, double** c, double alpha = 1.0);
+
+// C += alpha * A^T * B, where a is stored as k x m. No transposed copy is made
+void S21GemmTN(int m, int n, int k, const double* const* a,
+               const double* const* b, double** c, double alpha = 1.0);
+
+// C += alpha * A * B^T, where b is stored as n x k. No transposed copy is made
+void S21GemmNT(int m, int n, int k, const double* const* a,
+               const double* const* b, double** c, double alpha = 1.0);
+
+// Semirings of the product kernel. Plus accumulates the products, Times
+// combines an element of A with an element of B; kZero is the identity of
+// Plus and kOne the identity of Times
+struct S21PlusTimes {
+  static constexpr double kZero = 0, kOne = 1;
+  static double Plus(double x, double y) noexcept { return x + y; }
+  static double Times(double x, double y) noexcept { return x * y; }
+};
+
+// Tropical (min, +) semiring: the product of distance matrices gives the
+// shortest paths through one more intermediate vertex
+struct S21MinPlus {
+  static constexpr double kZero = std::numeric_limits<double>::infinity();
+  static constexpr double kOne = 0;
+  static double Plus(double x, double y) noexcept { return y < x ? y : x; }
+  static double Times(double x, double y) noexcept { return x + y; }
+};
+
+// (max, +) semiring: longest paths and critical paths of schedules
+struct S21MaxPlus {
+  static constexpr double kZero = -std::numeric_limits<double>::infinity();
+  static constexpr double kOne = 0;
+  static double Plus(double x, double y) noexcept { return y > x ? y : x; }
+  static double Times(double x, double y) noexcept { return x + y; }
+};
+
+// C = C (+) A (*) B with the operations of the semiring, where C starts as
+// kZero for a plain product. Instantiated for the semirings above
+template <typename Semiring>
+void S21SemiringGemm(int m, int n, int k, const double* const* a,
+                     const double* const* b, double** c);
+
+// Returns the dot product of two contiguous arrays of the given size
+double S21Dot(const double* x, const double* y, int size) noexcept;
+
+// Adds alpha * x to y element by element: y += alpha * x
+void S21Axpy(double alpha, const double* x, double* y, int size) noexcept;
+
+#endif  // S21_GEMM_H
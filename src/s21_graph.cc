@@ -0,0 +1,368 @@
+#include "s21_graph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// State of one evaluation. Every worker owns a deque of ready tasks: it takes
+// the newest task from its own deque, so a consumer usually runs right after
+// its operand on the same thread, and steals the oldest task of another deque
+// when its own is empty. The state is shared with the pool workers, which may
+// start only after the evaluation has finished
+struct Schedule {
+  struct Queue {
+    std::mutex mutex;
+    std::deque<int> tasks;
+  };
+
+  Schedule(int tasks, int workers)
+      : pending(new std::atomic<int>[tasks]),
+        consumers(tasks),
+        queues(workers),
+        remaining(tasks) {}
+
+  std::function<void(int)> execute;
+  std::unique_ptr<std::atomic<int>[]> pending;
+  std::vector<std::vector<int>> consumers;
+  std::vector<Queue> queues;
+  std::atomic<int> remaining;
+  std::atomic<int> ready{0};
+  std::atomic<int> running{0};
+  std::atomic<bool> failed{false};
+  std::mutex mutex;
+  std::exception_ptr error;
+};
+
+// Makes the task ready on the deque of the given worker
+void Push(Schedule &schedule, int worker, int task) {
+  {
+    Schedule::Queue &queue = schedule.queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(task);
+  }
+  schedule.ready++;
+  S21ThreadPool::Instance().Wake();
+}
+
+// Takes the newest task of the own deque or the oldest task of another one
+bool Take(Schedule &schedule, int worker, int &task) {
+  const int workers = static_cast<int>(schedule.queues.size());
+  for (int offset = 0; offset < workers; offset++) {
+    Schedule::Queue &queue = schedule.queues[(worker + offset) % workers];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) continue;
+    if (offset == 0) {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+    } else {
+      task = queue.tasks.front();
+      queue.tasks.pop_front();
+    }
+    schedule.ready--;
+    return true;
+  }
+  return false;
+}
+
+// Runs tasks until every task is done or one of them has thrown. While no
+// task is ready the worker runs other tasks of the pool, such as the chunks
+// of a parallel loop started by a running operation
+void Work(Schedule &schedule, int worker) {
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  for (;;) {
+    // A running worker keeps the caller of Evaluate waiting, so it must be
+    // counted before it checks that the evaluation hasn't failed
+    schedule.running++;
+    int task = 0;
+    const bool taken = !schedule.failed && Take(schedule, worker, task);
+    if (taken) {
+      try {
+        schedule.execute(task);
+        for (int consumer : schedule.consumers[task]) {
+          if (--schedule.pending[consumer] == 0) {
+            Push(schedule, worker, consumer);
+          }
+        }
+        if (--schedule.remaining == 0) pool.Wake();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(schedule.mutex);
+        if (!schedule.error) schedule.error = std::current_exception();
+        schedule.failed = true;
+      }
+    }
+    schedule.running--;
+    if (schedule.failed) pool.Wake();
+    if (taken) continue;
+    pool.HelpUntil([&schedule] {
+      return schedule.ready > 0 || schedule.remaining == 0 || schedule.failed;
+    });
+    if (schedule.remaining == 0 || schedule.failed) return;
+  }
+}
+
+}  // namespace
+
+// Creates an empty graph
+S21Graph::S21Graph() noexcept : reused_(0), executed_(0), peak_live_(0) {}
+
+// Returns the number of rows of the node result
+int S21Graph::GetRows(int node) const { return GetNode(node).rows; }
+
+// Returns the number of columns of the node result
+int S21Graph::GetCols(int node) const { return GetNode(node).cols; }
+
+// Returns the number of distinct recorded nodes
+int S21Graph::GetNodeCount() const noexcept {
+  return static_cast<int>(nodes_.size());
+}
+
+// Returns how many times an already recorded node was returned instead of a
+// new one
+int S21Graph::GetReusedCount() const noexcept { return reused_; }
+
+// Returns the number of operations run by the last evaluation
+int S21Graph::GetLastExecutedCount() const noexcept { return executed_; }
+
+// Returns the largest number of results held at once by the last evaluation
+int S21Graph::GetLastPeakLive() const noexcept { return peak_live_; }
+
+// Returns the node with the given index
+const S21Graph::Node &S21Graph::GetNode(int node) const {
+  if (node < 0 || node >= static_cast<int>(nodes_.size())) {
+    throw std::out_of_range("Node doesn't exist");
+  }
+  return nodes_[node];
+}
+
+// Returns the existing node for the same operation on the same operands or
+// records a new one
+int S21Graph::Record(Operation operation, int left, int right, double num,
+                     int rows, int cols) {
+  unsigned long long bits = 0;
+  std::memcpy(&bits, &num, sizeof(bits));
+  const auto key = std::make_tuple(operation, left, right, bits);
+  const auto found = known_.find(key);
+  if (found != known_.end()) {
+    reused_++;
+    return found->second;
+  }
+  nodes_.push_back(Node{operation, left, right, num, rows, cols, nullptr});
+  const int node = static_cast<int>(nodes_.size()) - 1;
+  known_.emplace(key, node);
+  return node;
+}
+
+// Records a copy of the matrix, the same unchanged matrix is recorded once.
+// Every write to a matrix gives it a new version, so a matrix changed between
+// two calls is recorded again
+int S21Graph::Input(const S21Matrix &matrix) {
+  const unsigned long long version = matrix.GetVersion();
+  const auto found = inputs_.find(version);
+  if (found != inputs_.end()) {
+    reused_++;
+    return found->second;
+  }
+  nodes_.push_back(Node{Operation::kInput, -1, -1, 0, matrix.GetRows(),
+                        matrix.GetCols(),
+                        std::make_shared<const S21Matrix>(matrix)});
+  const int node = static_cast<int>(nodes_.size()) - 1;
+  inputs_.emplace(version, node);
+  return node;
+}
+
+// Records the sum, the operands are ordered so a + b and b + a are one node
+int S21Graph::Sum(int left, int right) {
+  const Node &first = GetNode(left), &second = GetNode(right);
+  if (first.rows != second.rows || first.cols != second.cols) {
+    throw std::invalid_argument("Rows or columns are not equal");
+  }
+  return Record(Operation::kSum, std::min(left, right), std::max(left, right),
+                0, first.rows, first.cols);
+}
+
+// Records the difference
+int S21Graph::Sub(int left, int right) {
+  const Node &first = GetNode(left), &second = GetNode(right);
+  if (first.rows != second.rows || first.cols != second.cols) {
+    throw std::invalid_argument("Rows or columns are not equal");
+  }
+  return Record(Operation::kSub, left, right, 0, first.rows, first.cols);
+}
+
+// Records the product
+int S21Graph::Mul(int left, int right) {
+  const Node &first = GetNode(left), &second = GetNode(right);
+  if (first.cols != second.rows) {
+    throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+  }
+  return Record(Operation::kMul, left, right, 0, first.rows, second.cols);
+}
+
+// Records the multiplication by a number, multiplying by one records nothing
+int S21Graph::MulNumber(int node, double num) {
+  const Node &operand = GetNode(node);
+  if (num == 1.0) return node;
+  return Record(Operation::kMulNumber, node, -1, num, operand.rows,
+                operand.cols);
+}
+
+// Records the transpose, the transpose of a transpose is its operand
+int S21Graph::Transpose(int node) {
+  const Node &operand = GetNode(node);
+  if (operand.operation == Operation::kTranspose) {
+    reused_++;
+    return operand.left;
+  }
+  return Record(Operation::kTranspose, node, -1, 0, operand.cols,
+                operand.rows);
+}
+
+// Records the inverse, a singular matrix is only detected by Evaluate
+int S21Graph::Inverse(int node) {
+  const Node &operand = GetNode(node);
+  if (operand.rows != operand.cols) {
+    throw std::logic_error("The matrix is not square");
+  }
+  return Record(Operation::kInverse, node, -1, 0, operand.rows, operand.cols);
+}
+
+// Computes the result of one node
+S21Matrix S21Graph::Evaluate(int node) {
+  return std::move(Evaluate(std::vector<int>{node}).front());
+}
+
+// Computes the results of the given nodes. Nodes the outputs don't depend on
+// are skipped, an intermediate result is released by the thread that finishes
+// its last consumer. The first exception thrown by an operation is rethrown
+// once the running operations are done
+std::vector<S21Matrix> S21Graph::Evaluate(const std::vector<int> &outputs) {
+  const int count = static_cast<int>(nodes_.size());
+  std::vector<int> task_of(count, -1);
+  std::vector<bool> needed(count, false);
+  for (int output : outputs) {
+    GetNode(output);
+    needed[output] = true;
+  }
+  // Operands always precede their consumers, so one backward pass marks every
+  // node the outputs depend on
+  for (int node = count - 1; node >= 0; node--) {
+    const Node &current = nodes_[node];
+    if (!needed[node] || current.operation == Operation::kInput) continue;
+    needed[current.left] = true;
+    if (current.right >= 0) needed[current.right] = true;
+  }
+  std::vector<int> order;
+  for (int node = 0; node < count; node++) {
+    if (needed[node] && nodes_[node].operation != Operation::kInput) {
+      task_of[node] = static_cast<int>(order.size());
+      order.push_back(node);
+    }
+  }
+  executed_ = static_cast<int>(order.size());
+  peak_live_ = 0;
+
+  std::vector<std::shared_ptr<S21Matrix>> results(count);
+  if (!order.empty()) {
+    const int tasks = static_cast<int>(order.size());
+    S21ThreadPool &pool = S21ThreadPool::Instance();
+    const int workers = std::min(pool.GetThreadCount(), tasks);
+    auto schedule = std::make_shared<Schedule>(tasks, workers);
+    // Consumers left for every result, the outputs are held by the caller too
+    std::unique_ptr<std::atomic<int>[]> users(new std::atomic<int>[count]);
+    for (int node = 0; node < count; node++) users[node] = 0;
+    for (int output : outputs) users[output]++;
+    for (int task = 0; task < tasks; task++) {
+      const Node &current = nodes_[order[task]];
+      int pending = 0;
+      for (int operand : {current.left, current.right}) {
+        if (operand < 0 || task_of[operand] < 0) continue;
+        schedule->consumers[task_of[operand]].push_back(task);
+        users[operand]++;
+        pending++;
+      }
+      schedule->pending[task] = pending;
+    }
+    std::atomic<int> live{0}, peak{0};
+    schedule->execute = [this, &order, &results, &users, &live,
+                         &peak](int task) {
+      const int node = order[task];
+      const Node &current = nodes_[node];
+      const auto operand = [this, &results](int index) -> const S21Matrix & {
+        return nodes_[index].operation == Operation::kInput
+                   ? *nodes_[index].value
+                   : *results[index];
+      };
+      const S21Matrix &left = operand(current.left);
+      S21Matrix value;
+      switch (current.operation) {
+        case Operation::kSum:
+          value = left + operand(current.right);
+          break;
+        case Operation::kSub:
+          value = left - operand(current.right);
+          break;
+        case Operation::kMul:
+          value = left * operand(current.right);
+          break;
+        case Operation::kMulNumber:
+          value = left * current.num;
+          break;
+        case Operation::kTranspose:
+          value = left.Transpose();
+          break;
+        case Operation::kInverse:
+          value = left.InverseMatrix();
+          break;
+        case Operation::kInput:
+          break;
+      }
+      results[node] = std::make_shared<S21Matrix>(std::move(value));
+      const int now = ++live;
+      int seen = peak;
+      while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+      }
+      for (int index : {current.left, current.right}) {
+        if (index < 0 || nodes_[index].operation == Operation::kInput) continue;
+        if (--users[index] == 0) {
+          results[index].reset();
+          live--;
+        }
+      }
+    };
+    for (int task = 0, worker = 0; task < tasks; task++) {
+      if (schedule->pending[task] == 0) {
+        schedule->queues[worker].tasks.push_back(task);
+        schedule->ready++;
+        worker = (worker + 1) % workers;
+      }
+    }
+    for (int worker = 1; worker < workers; worker++) {
+      pool.Post([schedule, worker] { Work(*schedule, worker); });
+    }
+    Work(*schedule, 0);
+    pool.HelpUntil([&schedule] {
+      return schedule->remaining == 0 ||
+             (schedule->failed && schedule->running == 0);
+    });
+    peak_live_ = peak;
+    std::lock_guard<std::mutex> lock(schedule->mutex);
+    if (schedule->error) std::rethrow_exception(schedule->error);
+  }
+
+  std::vector<S21Matrix> values;
+  values.reserve(outputs.size());
+  for (int output : outputs) {
+    const Node &current = nodes_[output];
+    values.push_back(current.operation == Operation::kInput ? *current.value
+                                                            : *results[output]);
+  }
+  return values;
+}
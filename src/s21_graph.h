@@ -0,0 +1,69 @@
+#ifndef S21_GRAPH_H
+#define S21_GRAPH_H
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Deferred evaluation of matrix expressions. Operations are recorded as nodes
+// of a directed acyclic graph, equal subexpressions are recorded only once and
+// nothing is computed before Evaluate. Evaluate runs only the nodes the
+// requested outputs depend on, independent nodes run concurrently on a
+// work-stealing scheduler and every intermediate result is freed as soon as
+// its last consumer is done
+class S21Graph {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  S21Graph() noexcept;
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetRows(int node) const;
+  int GetCols(int node) const;
+  int GetNodeCount() const noexcept;
+  int GetReusedCount() const noexcept;
+  int GetLastExecutedCount() const noexcept;
+  int GetLastPeakLive() const noexcept;
+
+  /* ============================== Functions =============================== */
+  int Input(const S21Matrix& matrix);
+  int Sum(int left, int right);
+  int Sub(int left, int right);
+  int Mul(int left, int right);
+  int MulNumber(int node, double num);
+  int Transpose(int node);
+  int Inverse(int node);
+  S21Matrix Evaluate(int node);
+  std::vector<S21Matrix> Evaluate(const std::vector<int>& outputs);
+
+ private:
+  enum class Operation { kInput, kSum, kSub, kMul, kMulNumber, kTranspose,
+                         kInverse };
+  struct Node {
+    Operation operation;
+    int left, right;
+    double num;
+    int rows, cols;
+    // Only inputs keep their values between evaluations
+    std::shared_ptr<const S21Matrix> value;
+  };
+
+  /* ============================= Attributes =============================== */
+  std::vector<Node> nodes_;
+  // Keys of recorded operations: operation, operands and the bits of num
+  std::map<std::tuple<Operation, int, int, unsigned long long>, int> known_;
+  // Inputs by the version of the matrix, equal versions mean equal contents
+  std::map<unsigned long long, int> inputs_;
+  int reused_;
+  int executed_;
+  int peak_live_;
+
+  /* ============================== Methods ================================= */
+  int Record(Operation operation, int left, int right, double num, int rows,
+             int cols);
+  const Node& GetNode(int node) const;
+};
+
+#endif  // S21_GRAPH_H
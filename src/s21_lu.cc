@@ -0,0 +1,380 @@
+#include "s21_lu.h"
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+#include "s21_gemm.h"
+#include "s21_thread_pool.h"
+
+// Width of the column tiles: the panel factorized by one task and the block
+// of columns updated by one task
+static constexpr int kPanelWidth = 64;
+// Number of right-hand side columns solved by one task
+static constexpr int kRhsBlock = 64;
+
+// Factorizes the given square matrix
+S21LU::S21LU(const S21Matrix &matrix)
+    : lu_(matrix), pivots_(), sign_(1), singular_(false) {
+  if (matrix.rows_ != matrix.cols_) {
+    throw std::logic_error("The matrix is not square");
+  }
+  if (matrix.rows_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+  lu_.Detach();
+  Factorize();
+  lu_.Touch();
+}
+
+// Returns the order of the factorized matrix
+int S21LU::GetSize() const noexcept { return lu_.rows_; }
+
+// Checks if a zero pivot was met during the factorization
+bool S21LU::IsSingular() const noexcept { return singular_; }
+
+// Returns L and U packed in one matrix
+const S21Matrix &S21LU::GetPacked() const noexcept { return lu_; }
+
+// Returns the row swapped with each row during the factorization
+const std::vector<int> &S21LU::GetPivots() const noexcept { return pivots_; }
+
+// Returns the unit lower triangular factor
+S21Matrix S21LU::GetL() const {
+  S21Matrix lower(lu_.rows_, lu_.cols_);
+  for (int i = 0; i < lu_.rows_; i++) {
+    for (int j = 0; j < lu_.cols_; j++) {
+      lower.matrix_[i][j] = j < i ? lu_.matrix_[i][j] : (i == j ? 1.0 : 0.0);
+    }
+  }
+  return lower;
+}
+
+// Returns the upper triangular factor
+S21Matrix S21LU::GetU() const {
+  S21Matrix upper(lu_.rows_, lu_.cols_);
+  for (int i = 0; i < lu_.rows_; i++) {
+    for (int j = 0; j < lu_.cols_; j++) {
+      upper.matrix_[i][j] = j >= i ? lu_.matrix_[i][j] : 0.0;
+    }
+  }
+  return upper;
+}
+
+// Runs a task graph on every thread of the pool. pending[t] counts the
+// unfinished dependencies of task t, tasks already done or never used have a
+// negative count. Ready tasks are taken in the order of priority (lower
+// first), run(t) executes task t and successors(t) lists the tasks depending
+// on it. A runner with no ready task runs other tasks of the pool, such as
+// the chunks of a parallel loop started by a running task. Runners posted to
+// the pool that start after the graph is done leave at once, so the caller
+// only waits for the runners that took part, and a factorization started on a
+// pool thread can't deadlock
+static void RunTaskGraph(
+    std::vector<int> pending, const std::vector<long long> &priority,
+    const std::function<void(int)> &run,
+    const std::function<std::vector<int>(int)> &successors) {
+  using Ready = std::pair<long long, int>;
+  struct Graph {
+    std::mutex mutex;
+    std::priority_queue<Ready, std::vector<Ready>, std::greater<Ready>> ready;
+    std::vector<int> pending;
+    int remaining = 0, active = 0;
+    std::exception_ptr error;
+  };
+  auto graph = std::make_shared<Graph>();
+  graph->pending = std::move(pending);
+  for (size_t task = 0; task < graph->pending.size(); task++) {
+    if (graph->pending[task] >= 0) graph->remaining++;
+    if (graph->pending[task] == 0) {
+      graph->ready.emplace(priority[task], static_cast<int>(task));
+    }
+  }
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  // priority, run and successors are only referenced by runners that joined
+  // before the graph finished, the caller waits for all of them. The graph
+  // lock is never held while the pool is woken
+  auto runner = [graph, &pool, &priority, &run, &successors] {
+    std::unique_lock<std::mutex> lock(graph->mutex);
+    if (graph->remaining == 0 || graph->error) return;
+    graph->active++;
+    for (;;) {
+      if (graph->remaining == 0 || graph->error) break;
+      if (graph->ready.empty()) {
+        lock.unlock();
+        pool.HelpUntil([&graph] {
+          std::lock_guard<std::mutex> guard(graph->mutex);
+          return !graph->ready.empty() || graph->remaining == 0 ||
+                 graph->error;
+        });
+        lock.lock();
+        continue;
+      }
+      const int task = graph->ready.top().second;
+      graph->ready.pop();
+      lock.unlock();
+      std::vector<int> next;
+      try {
+        run(task);
+        next = successors(task);
+      } catch (...) {
+        lock.lock();
+        if (!graph->error) graph->error = std::current_exception();
+        break;
+      }
+      lock.lock();
+      graph->remaining--;
+      for (int successor : next) {
+        if (--graph->pending[successor] == 0) {
+          graph->ready.emplace(priority[successor], successor);
+        }
+      }
+      lock.unlock();
+      pool.Wake();
+      lock.lock();
+    }
+    graph->active--;
+    lock.unlock();
+    pool.Wake();
+  };
+  for (int i = 1; i < pool.GetThreadCount(); i++) {
+    pool.Post(runner);
+  }
+  runner();
+  pool.HelpUntil([&graph] {
+    std::lock_guard<std::mutex> lock(graph->mutex);
+    return graph->active == 0;
+  });
+  std::lock_guard<std::mutex> lock(graph->mutex);
+  if (graph->error) std::rethrow_exception(graph->error);
+}
+
+// Tiled factorization driven by a task graph. The columns are split into
+// tiles of kPanelWidth; on step k the panel task factorizes tile k with
+// partial pivoting, and an update task per tile j > k applies the panel's row
+// swaps to tile j, solves its block row with the unit L of the panel (TRSM)
+// and subtracts L * U from the rows below (GEMM). The update of tile j on step
+// k waits for the panel of step k and the update of tile j on step k - 1; the
+// panel of step k + 1 only waits for the update of its own tile, and it goes
+// before the other updates of step k. So the next panels are factorized while
+// the trailing updates are still running (lookahead) and the panels, which are
+// the critical path, never wait for the whole trailing matrix. The swaps of
+// every panel are applied to the columns left of it at the end
+void S21LU::Factorize() {
+  const int n = lu_.rows_;
+  const int tiles = (n + kPanelWidth - 1) / kPanelWidth;
+  pivots_.resize(n);
+  // Task (k, j) is the panel of step k for j == k, the update of tile j on
+  // step k for j > k
+  const auto id = [tiles](int k, int j) { return k * tiles + j; };
+  const size_t count = static_cast<size_t>(tiles) * tiles;
+  std::vector<int> pending(count, -1);
+  std::vector<long long> priority(count, 0);
+  for (int k = 0; k < tiles; k++) {
+    pending[id(k, k)] = k > 0 ? 1 : 0;
+    priority[id(k, k)] = static_cast<long long>(k) * (tiles + 1);
+    for (int j = k + 1; j < tiles; j++) {
+      pending[id(k, j)] = k > 0 ? 2 : 1;
+      priority[id(k, j)] = static_cast<long long>(k + 1) * (tiles + 1) + j - k;
+    }
+  }
+  RunTaskGraph(
+      std::move(pending), priority,
+      [this, tiles, n](int task) {
+        const int k = task / tiles, j = task % tiles;
+        const int from = k * kPanelWidth;
+        const int to = std::min(n, from + kPanelWidth);
+        if (j == k) {
+          FactorizePanel(from, to);
+        } else {
+          const int first = j * kPanelWidth;
+          UpdateTile(from, to, first, std::min(n, first + kPanelWidth));
+        }
+      },
+      [tiles, &id](int task) {
+        const int k = task / tiles, j = task % tiles;
+        std::vector<int> next;
+        if (j == k) {
+          for (int t = k + 1; t < tiles; t++) next.push_back(id(k, t));
+        } else if (j == k + 1) {
+          next.push_back(id(j, j));
+        } else {
+          next.push_back(id(k + 1, j));
+        }
+        return next;
+      });
+  S21ThreadPool::Instance().ParallelFor(
+      0, tiles - 1, 1, [this, tiles, n](int begin, int end) {
+        for (int j = begin; j < end; j++) {
+          const int first = j * kPanelWidth;
+          for (int k = j + 1; k < tiles; k++) {
+            const int from = k * kPanelWidth;
+            SwapRows(from, std::min(n, from + kPanelWidth), first,
+                     first + kPanelWidth);
+          }
+        }
+      });
+}
+
+// Applies the row swaps of the panel [from, to) to columns [first, last)
+void S21LU::SwapRows(int from, int to, int first, int last) noexcept {
+  double **a = lu_.matrix_;
+  for (int j = from; j < to; j++) {
+    if (pivots_[j] != j) {
+      std::swap_ranges(a[j] + first, a[j] + last, a[pivots_[j]] + first);
+    }
+  }
+}
+
+// Factorizes the columns [from, to) of the rows below from, swapping only the
+// panel's part of the rows; the other tiles get the swaps from their updates
+void S21LU::FactorizePanel(int from, int to) {
+  const int n = lu_.rows_;
+  double **a = lu_.matrix_;
+  for (int j = from; j < to; j++) {
+    int pivot = j;
+    for (int i = j + 1; i < n; i++) {
+      if (fabs(a[i][j]) > fabs(a[pivot][j])) pivot = i;
+    }
+    pivots_[j] = pivot;
+    if (pivot != j) {
+      std::swap_ranges(a[j] + from, a[j] + to, a[pivot] + from);
+      sign_ = -sign_;
+    }
+    if (a[j][j] == 0.0) {
+      singular_ = true;
+      continue;
+    }
+    const double inverse = 1.0 / a[j][j];
+    for (int i = j + 1; i < n; i++) {
+      double *row = a[i];
+      row[j] *= inverse;
+      const double factor = row[j];
+      for (int c = j + 1; c < to; c++) {
+        row[c] -= factor * a[j][c];
+      }
+    }
+  }
+}
+
+// Updates the columns [first, last) with the panel [from, to): the panel's
+// swaps are applied, the block row of the panel is solved with its unit
+// lower triangle, then the product of the panel's L below the block row and
+// that U block is subtracted from the rows below by GEMM
+void S21LU::UpdateTile(int from, int to, int first, int last) {
+  const int n = lu_.rows_;
+  double **a = lu_.matrix_;
+  SwapRows(from, to, first, last);
+  for (int r = from + 1; r < to; r++) {
+    double *row = a[r];
+    for (int t = from; t < r; t++) {
+      const double factor = row[t];
+      const double *source = a[t];
+      for (int c = first; c < last; c++) {
+        row[c] -= factor * source[c];
+      }
+    }
+  }
+  if (to == n) return;
+  std::vector<const double *> lower(n - to), upper(to - from);
+  std::vector<double *> target(n - to);
+  for (int i = to; i < n; i++) {
+    lower[i - to] = a[i] + from;
+    target[i - to] = a[i] + first;
+  }
+  for (int t = from; t < to; t++) {
+    upper[t - from] = a[t] + first;
+  }
+  S21Gemm(n - to, last - first, to - from, lower.data(), upper.data(),
+          target.data(), -1.0);
+}
+
+// Checks if the right-hand side can be solved with the factorization
+void S21LU::CheckRhs(const S21Matrix &rhs) const {
+  if (rhs.rows_ != lu_.rows_) {
+    throw std::invalid_argument(
+        "Right-hand side rows are not equal to the matrix size");
+  }
+  if (singular_) {
+    throw std::logic_error("The matrix is singular");
+  }
+}
+
+// Solves A * X = rhs for every column of rhs and returns X
+S21Matrix S21LU::Solve(const S21Matrix &rhs) const {
+  S21Matrix result(rhs);
+  SolveInPlace(result);
+  return result;
+}
+
+// Solves A * X = rhs for every column of rhs, overwriting rhs with X. Blocks of
+// right-hand side columns are solved in parallel, each with row-oriented
+// forward and backward substitution
+void S21LU::SolveInPlace(S21Matrix &rhs) const {
+  CheckRhs(rhs);
+  rhs.Detach();
+  const int n = lu_.rows_;
+  double **a = lu_.matrix_;
+  double **b = rhs.matrix_;
+  for (int i = 0; i < n; i++) {
+    if (pivots_[i] != i) {
+      std::swap_ranges(b[i], b[i] + rhs.cols_, b[pivots_[i]]);
+    }
+  }
+  const int blocks = (rhs.cols_ + kRhsBlock - 1) / kRhsBlock;
+  S21ThreadPool::Instance().ParallelFor(
+      0, blocks, 1, [a, b, n, &rhs](int first, int last) {
+        const int begin = first * kRhsBlock;
+        const int end = std::min(rhs.cols_, last * kRhsBlock);
+        for (int i = 1; i < n; i++) {
+          double *target = b[i];
+          for (int t = 0; t < i; t++) {
+            const double factor = a[i][t];
+            const double *source = b[t];
+            for (int c = begin; c < end; c++) {
+              target[c] -= factor * source[c];
+            }
+          }
+        }
+        for (int i = n - 1; i >= 0; i--) {
+          double *target = b[i];
+          for (int t = i + 1; t < n; t++) {
+            const double factor = a[i][t];
+            const double *source = b[t];
+            for (int c = begin; c < end; c++) {
+              target[c] -= factor * source[c];
+            }
+          }
+          const double inverse = 1.0 / a[i][i];
+          for (int c = begin; c < end; c++) {
+            target[c] *= inverse;
+          }
+        }
+      });
+  rhs.Touch();
+}
+
+// Returns the determinant as the signed product of the U diagonal
+double S21LU::Determinant() const noexcept {
+  double determinant = sign_;
+  for (int i = 0; i < lu_.rows_; i++) {
+    determinant *= lu_.matrix_[i][i];
+  }
+  return determinant;
+}
+
+// Returns the inverse matrix by solving against the identity
+S21Matrix S21LU::Inverse() const {
+  S21Matrix inversed(lu_.rows_, lu_.cols_);
+  for (int i = 0; i < lu_.rows_; i++) {
+    for (int j = 0; j < lu_.cols_; j++) {
+      inversed.matrix_[i][j] = i == j ? 1.0 : 0.0;
+    }
+  }
+  SolveInPlace(inversed);
+  return inversed;
+}
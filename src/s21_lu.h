@@ -0,0 +1,45 @@
+#ifndef S21_LU_H
+#define S21_LU_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization with partial pivoting, P * A = L * U. L (unit diagonal) and
+// U are stored packed in one matrix, pivots_[i] is the row swapped with row i
+// on step i
+class S21LU {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21LU(const S21Matrix& matrix);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  bool IsSingular() const noexcept;
+  const S21Matrix& GetPacked() const noexcept;
+  const std::vector<int>& GetPivots() const noexcept;
+  S21Matrix GetL() const;
+  S21Matrix GetU() const;
+
+  /* ============================== Functions =============================== */
+  S21Matrix Solve(const S21Matrix& rhs) const;
+  void SolveInPlace(S21Matrix& rhs) const;
+  double Determinant() const noexcept;
+  S21Matrix Inverse() const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  S21Matrix lu_;
+  std::vector<int> pivots_;
+  int sign_;
+  bool singular_;
+
+  /* ============================== Methods ================================= */
+  void Factorize();
+  void FactorizePanel(int from, int to);
+  void UpdateTile(int from, int to, int first, int last);
+  void SwapRows(int from, int to, int first, int last) noexcept;
+  void CheckRhs(const S21Matrix& rhs) const;
+};
+
+#endif  // S21_LU_H
@@ -1,10 +1,74 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cstring>
+#include <limits>
+
+#include "s21_bit_matrix.h"
+#include "s21_chain.h"
+#include "s21_cholesky.h"
+#include "s21_eigen.h"
+#include "s21_gemm.h"
+#include "s21_lu.h"
+#include "s21_memory.h"
+#include "s21_mixed_lu.h"
+#include "s21_qr.h"
+#include "s21_reduce.h"
+#include "s21_svd.h"
+#include "s21_thread_pool.h"
+#include "s21_vector.h"
+
+// Largest order for which determinants and inverses are found by cofactor
+// expansion, which is cheaper than LU for tiny matrices and exact on integers
+static constexpr int kCofactorMaxSize = 3;
+// Matrix-vector kernels with fewer cells than this run on one thread
+static constexpr long long kParallelCells = 1LL << 15;
+// Minimal number of columns given to one thread by MulVectorTransposed
+static constexpr int kColumnGrain = 512;
+// Minimal number of rows whose absolute sums one thread computes for the
+// infinity norm
+static constexpr int kNormRowGrain = 64;
+// Side of the square tiles in which a transposed operand is read, a tile of
+// both matrices stays in L1
+static constexpr int kTransposeTile = 32;
+// Rows of the product or columns of the inverse computed by one step of an
+// asynchronous operation, cancellation and progress are checked between steps
+static constexpr int kAsyncStep = 128;
+// Share of the LU factorization in the work of an inverse: 2/3 n^3 of the
+// 8/3 n^3 multiplications
+static constexpr double kFactorizationShare = 0.25;
+// Rows zeroed or copied by one chunk of a placement loop, the same chunk the
+// product kernel hands to a thread
+static constexpr int kPlacementGrain = 16;
+// Cells reduced or mapped by one task of a reduction or an elementwise
+// operation. The split doesn't depend on the number of threads, so reductions
+// give the same result on every machine
+static constexpr size_t kReduceChunk = 1 << 14;
+
+// Returns a version number that was never handed out before, so equal versions
+// always mean equal contents (copies share the version of their source)
+static unsigned long long NextVersion() noexcept {
+  static std::atomic<unsigned long long> counter{0};
+  return ++counter;
+}
+
+// Whether copies share the cells of their source until one of them changes
+static std::atomic<bool> copy_on_write{false};
+
+// Releases a block of cells and its row pointers
+static void FreeCells(double **rows, size_t count) noexcept {
+  S21Deallocate(rows[0], count);
+  delete[] rows;
+}
+
 // Default constructor
-S21Matrix::S21Matrix() noexcept : rows_{}, cols_{}, matrix_{} {}
+S21Matrix::S21Matrix() noexcept
+    : rows_{}, cols_{}, matrix_{}, references_{}, version_{} {}
 
 // Parameterized constructor
-S21Matrix::S21Matrix(int rows, int cols) {
+S21Matrix::S21Matrix(int rows, int cols) : references_{}, version_{} {
   if (rows < 1 || cols < 1) {
     throw std::invalid_argument("Rows or columns can't be less than 1");
   }
@@ -13,11 +77,65 @@ S21Matrix::S21Matrix(int rows, int cols) {
   InitMatrix();
 }
 
-// Allocates memory for the matrix and initializes each cell with zero
-void S21Matrix::InitMatrix() {
+// Calls body(first_row, last_row) for ranges covering the rows of a matrix.
+// Under the default NUMA policy and for small matrices the caller does all
+// rows, otherwise the rows are split into the chunks of the compute kernels,
+// so the pages of a chunk are first written by a thread of the pool
+static void ForRowPartitions(int rows, int cols,
+                             const std::function<void(int, int)> &body) {
+  const long long cells = static_cast<long long>(rows) * cols;
+  if (S21GetNumaPolicy() == S21NumaPolicy::kDefault ||
+      cells < kParallelCells) {
+    body(0, rows);
+  } else {
+    S21ThreadPool::Instance().ParallelFor(0, rows, kPlacementGrain, body);
+  }
+}
+
+// Returns chunk(first, count) for consecutive chunks of count cells starting
+// at first. Chunks are split between threads for large matrices
+template <typename T, typename Chunk>
+static std::vector<T> ReduceChunks(size_t cells, const Chunk &chunk) {
+  const int chunks =
+      static_cast<int>((cells + kReduceChunk - 1) / kReduceChunk);
+  std::vector<T> partials(chunks);
+  S21ThreadPool::Instance().ParallelFor(
+      0, chunks, static_cast<long long>(cells) < kParallelCells ? chunks : 1,
+      [&partials, &chunk, cells](int begin, int end) {
+        for (int c = begin; c < end; c++) {
+          const size_t first = c * kReduceChunk;
+          partials[c] = chunk(first, std::min(kReduceChunk, cells - first));
+        }
+      });
+  return partials;
+}
+
+// Allocates memory for the matrix and initializes each cell with zero unless
+// the cells are about to be overwritten. The cells live in one contiguous
+// block and matrix_ holds pointers to its rows
+void S21Matrix::InitMatrix(bool zero) {
+  if (rows_ < 1 || cols_ < 1) {
+    matrix_ = nullptr;
+    return;
+  }
   matrix_ = new double *[rows_];
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_];
+  try {
+    matrix_[0] = S21Allocate(static_cast<size_t>(rows_) * cols_);
+  } catch (...) {
+    delete[] matrix_;
+    matrix_ = nullptr;
+    throw;
+  }
+  for (int i = 1; i < rows_; i++) {
+    matrix_[i] = matrix_[i - 1] + cols_;
+  }
+  if (zero) {
+    double **rows = matrix_;
+    const int cols = cols_;
+    ForRowPartitions(rows_, cols_, [rows, cols](int begin, int end) {
+      std::fill(rows[begin], rows[begin] + static_cast<size_t>(end - begin) *
+                                               cols, 0.0);
+    });
   }
 }
 
@@ -26,21 +144,90 @@ S21Matrix::~S21Matrix() { ClearMatrix(); }
 
 // Copy constructor
 S21Matrix::S21Matrix(const S21Matrix &other)
-    : rows_(other.rows_), cols_(other.cols_) {
+    : rows_(other.rows_), cols_(other.cols_), references_{}, version_{} {
   if (&other == this) {
     throw std::logic_error("Self-copying is not allowed");
   }
-  CopyMatrix(other);
+  if (!ShareMatrix(other)) {
+    CopyMatrix(other);
+  }
+  AdoptCache(other);
 }
 
 // Copies the given matrix into the current matrix
 void S21Matrix::CopyMatrix(const S21Matrix &other) {
-  InitMatrix();
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = other.matrix_[i][j];
+  CopyCells(other.matrix_);
+}
+
+// Allocates the cells and copies them from the rows of a matrix of the same
+// size
+void S21Matrix::CopyCells(const double *const *source) {
+  InitMatrix(false);
+  if (matrix_) {
+    double **rows = matrix_;
+    const int cols = cols_;
+    ForRowPartitions(rows_, cols_, [rows, source, cols](int begin, int end) {
+      std::copy(source[begin],
+                source[begin] + static_cast<size_t>(end - begin) * cols,
+                rows[begin]);
+    });
+  }
+}
+
+// Makes the matrix refer to the cells of the other matrix when copy-on-write
+// is on and returns whether it did. The reference count is created by the
+// first share under the cache lock of the source, so concurrent copies of one
+// matrix agree on it
+bool S21Matrix::ShareMatrix(const S21Matrix &other) {
+  if (!copy_on_write || !other.matrix_) {
+    return false;
+  }
+  std::lock_guard<std::recursive_mutex> lock(other.cache_mutex_);
+  if (!other.references_) {
+    other.references_ = new std::atomic<long>(1);
+  }
+  other.references_->fetch_add(1, std::memory_order_relaxed);
+  matrix_ = other.matrix_;
+  references_ = other.references_;
+  return true;
+}
+
+// Gives the matrix cells of its own before they are modified. The last owner
+// of shared cells keeps them, the others copy them and drop their reference
+void S21Matrix::Detach() {
+  if (!references_) return;
+  std::atomic<long> *references = references_;
+  if (references->load(std::memory_order_acquire) > 1) {
+    double **shared = matrix_;
+    try {
+      CopyCells(shared);
+    } catch (...) {
+      matrix_ = shared;
+      throw;
+    }
+    if (references->fetch_sub(1, std::memory_order_acq_rel) > 1) {
+      references_ = nullptr;
+      return;
     }
+    FreeCells(shared, static_cast<size_t>(rows_) * cols_);
   }
+  delete references;
+  references_ = nullptr;
+}
+
+// Turns copy-on-write on or off for the copies made from now on. Any matrix
+// is shared, also one filled through operator(): a write through a cell
+// detaches the written matrix first
+void S21Matrix::SetCopyOnWrite(bool enabled) noexcept {
+  copy_on_write = enabled;
+}
+
+// Checks if copies share their cells until modified
+bool S21Matrix::GetCopyOnWrite() noexcept { return copy_on_write; }
+
+// Checks if other matrices currently share the cells of the matrix
+bool S21Matrix::IsShared() const noexcept {
+  return references_ && references_->load(std::memory_order_acquire) > 1;
 }
 
 // Move constructor
@@ -49,18 +236,29 @@ S21Matrix::S21Matrix(S21Matrix &&other) noexcept {
     rows_ = std::exchange(other.rows_, 0);
     cols_ = std::exchange(other.cols_, 0);
     matrix_ = std::exchange(other.matrix_, nullptr);
+    references_ = std::exchange(other.references_, nullptr);
+    version_ = other.version_.exchange(0);
+    cache_ = std::exchange(other.cache_, {});
   }
 }
 
-// Clears the memory and sets the number of rows and columns to zero
+// Clears the memory and sets the number of rows and columns to zero. Shared
+// cells are released by their last owner
 void S21Matrix::ClearMatrix() noexcept {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
+  const size_t count = static_cast<size_t>(rows_) * cols_;
+  if (references_) {
+    if (references_->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      FreeCells(matrix_, count);
+      delete references_;
+    }
+  } else if (matrix_) {
+    FreeCells(matrix_, count);
   }
-  delete[] matrix_;
+  references_ = {};
   matrix_ = {};
   rows_ = {};
   cols_ = {};
+  Touch();
 }
 
 // Returns the number of rows in the matrix
@@ -69,6 +267,45 @@ int S21Matrix::GetRows() const noexcept { return rows_; }
 // Returns the number of columns in the matrix
 int S21Matrix::GetCols() const noexcept { return cols_; }
 
+// Returns the modification version of the matrix. The first call after a
+// change takes a new number, so a matrix written cell by cell draws on the
+// global counter once and not on every write
+unsigned long long S21Matrix::GetVersion() const noexcept {
+  unsigned long long version = version_.load(std::memory_order_acquire);
+  if (version == 0) {
+    const unsigned long long next = NextVersion();
+    if (version_.compare_exchange_strong(version, next,
+                                         std::memory_order_acq_rel)) {
+      version = next;
+    }
+  }
+  return version;
+}
+
+// Marks the matrix as modified, invalidating all cached derived results
+void S21Matrix::Touch() noexcept {
+  version_.store(0, std::memory_order_release);
+}
+
+// Returns the cache of derived results, dropping it first if it was computed
+// for an older version of the matrix
+S21Matrix::DerivedCache &S21Matrix::ValidCache() const noexcept {
+  const unsigned long long version = GetVersion();
+  if (cache_.version != version) {
+    cache_ = DerivedCache{};
+    cache_.version = version;
+  }
+  return cache_;
+}
+
+// Takes over the version and the cached results of the matrix the cells were
+// copied from
+void S21Matrix::AdoptCache(const S21Matrix &other) {
+  std::lock_guard<std::recursive_mutex> lock(other.cache_mutex_);
+  version_.store(other.GetVersion(), std::memory_order_release);
+  cache_ = other.cache_;
+}
+
 // Help function to copy matrix values
 void S21Matrix::FillMatrix(S21Matrix &newMatrix, int rows, int cols) {
   for (int i = 0; i < rows; i++) {
@@ -85,7 +322,7 @@ void S21Matrix::SetRows(int rows) {
   double edge = rows_;
   if (rows < rows_) edge = rows;
   FillMatrix(newMatrix, edge, cols_);
-  *this = newMatrix;
+  *this = std::move(newMatrix);
 }
 
 // Sets the number of columns in the matrix (if greater than the current number
@@ -95,7 +332,7 @@ void S21Matrix::SetCols(int cols) {
   double edge = cols_;
   if (cols < cols_) edge = cols;
   FillMatrix(newMatrix, rows_, edge);
-  *this = newMatrix;
+  *this = std::move(newMatrix);
 }
 
 // Checks if the matrix is equal to the given matrix
@@ -115,24 +352,289 @@ bool S21Matrix::EqMatrix(const S21Matrix &other) const noexcept {
   return true;
 }
 
+// Checks if the matrix is square and every element above the diagonal is zero
+bool S21Matrix::IsLowerTriangular() const noexcept {
+  if (rows_ != cols_) return false;
+  for (int i = 0; i < rows_; i++) {
+    for (int j = i + 1; j < cols_; j++) {
+      if (matrix_[i][j] != 0) return false;
+    }
+  }
+  return true;
+}
+
+// Checks if the matrix is square and every element below the diagonal is zero
+bool S21Matrix::IsUpperTriangular() const noexcept {
+  if (rows_ != cols_) return false;
+  for (int i = 1; i < rows_; i++) {
+    for (int j = 0; j < i; j++) {
+      if (matrix_[i][j] != 0) return false;
+    }
+  }
+  return true;
+}
+
+// Returns the sum of the diagonal elements. Neumaier's compensated sum keeps
+// the bits lost by every addition, the diagonal is too sparse to sum pairwise
+double S21Matrix::Trace() const {
+  CheckIfSquare();
+  double sum = 0, compensation = 0;
+  for (int i = 0; i < rows_; i++) {
+    const double value = matrix_[i][i], total = sum + value;
+    if (fabs(sum) >= fabs(value)) {
+      compensation += (sum - total) + value;
+    } else {
+      compensation += (value - total) + sum;
+    }
+    sum = total;
+  }
+  return sum + compensation;
+}
+
+// Returns the norm of the given type, 0 for an empty matrix and NaN when an
+// element is NaN. Norms are cached until the matrix changes
+double S21Matrix::Norm(NormType type) const {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  std::optional<double> &norm = ValidCache().norms[static_cast<int>(type)];
+  if (!norm) {
+    norm = ComputeNorm(type);
+  }
+  return *norm;
+}
+
+// Computes the norm of the given type. The cells are reduced in one pass over
+// the contiguous block, on several threads for large matrices. The Frobenius
+// norm takes a second pass, scaled by the largest element, only when the
+// plain sum of squares overflows or underflows
+double S21Matrix::ComputeNorm(NormType type) const {
+  if (rows_ < 1) return 0;
+  const double *cells = matrix_[0];
+  const size_t count = static_cast<size_t>(rows_) * cols_;
+  const int rows = rows_, cols = cols_;
+  const long long size = static_cast<long long>(count);
+  auto max_abs = [cells, count] {
+    std::vector<double> partials =
+        ReduceChunks<double>(count, [cells](size_t first, size_t number) {
+          return S21MaxAbs(cells + first, number);
+        });
+    return S21MaxAbs(partials.data(), partials.size());
+  };
+  auto square_sum = [cells, count](double scale) {
+    std::vector<double> partials = ReduceChunks<double>(
+        count, [cells, scale](size_t first, size_t number) {
+          return S21SquareSum(cells + first, number, scale);
+        });
+    return S21Sum(partials.data(), partials.size());
+  };
+  double norm = 0;
+  if (type == NormType::kMax) {
+    norm = max_abs();
+  } else if (type == NormType::kFrobenius) {
+    const double sum = square_sum(1.0);
+    if (std::isfinite(sum) && sum >= DBL_MIN / DBL_EPSILON) {
+      norm = sqrt(sum);
+    } else {
+      const double largest = max_abs();
+      norm = largest == 0 || !std::isfinite(largest)
+                 ? largest
+                 : largest * sqrt(square_sum(largest));
+    }
+  } else if (type == NormType::kInf) {
+    std::vector<double> sums(rows);
+    S21ThreadPool::Instance().ParallelFor(
+        0, rows, size < kParallelCells ? rows : kNormRowGrain,
+        [&sums, cells, cols](int begin, int end) {
+          for (int i = begin; i < end; i++) {
+            sums[i] = S21AbsSum(cells + static_cast<size_t>(i) * cols, cols);
+          }
+        });
+    norm = S21MaxAbs(sums.data(), sums.size());
+  } else if (type == NormType::kOne) {
+    // Every thread owns a slab of columns and adds the rows into it, the
+    // inner loop runs over contiguous cells
+    std::vector<double> sums(cols, 0.0);
+    S21ThreadPool::Instance().ParallelFor(
+        0, cols, size < kParallelCells ? cols : kColumnGrain,
+        [&sums, cells, rows, cols](int begin, int end) {
+          for (int i = 0; i < rows; i++) {
+            const double *row = cells + static_cast<size_t>(i) * cols;
+            for (int j = begin; j < end; j++) {
+              sums[j] += fabs(row[j]);
+            }
+          }
+        });
+    norm = S21MaxAbs(sums.data(), sums.size());
+  }
+  return norm;
+}
+
+// Returns the sum of all elements, summed pairwise in chunks
+double S21Matrix::Sum() const {
+  if (rows_ < 1) return 0;
+  const double *cells = matrix_[0];
+  std::vector<double> partials = ReduceChunks<double>(
+      static_cast<size_t>(rows_) * cols_,
+      [cells](size_t first, size_t number) {
+        return S21Sum(cells + first, number);
+      });
+  return S21Sum(partials.data(), partials.size());
+}
+
+// Returns the smallest element, NaN when an element is NaN
+double S21Matrix::Min() const {
+  const std::pair<int, int> position = ArgMin();
+  return matrix_[position.first][position.second];
+}
+
+// Returns the largest element, NaN when an element is NaN
+double S21Matrix::Max() const {
+  const std::pair<int, int> position = ArgMax();
+  return matrix_[position.first][position.second];
+}
+
+// Returns the row and column of the first smallest element in row-major order,
+// or of the first NaN when there is one
+std::pair<int, int> S21Matrix::ArgMin() const {
+  CheckIfNotEmpty();
+  const double *cells = matrix_[0];
+  std::vector<size_t> partials = ReduceChunks<size_t>(
+      static_cast<size_t>(rows_) * cols_,
+      [cells](size_t first, size_t number) {
+        return first + S21ArgMin(cells + first, number);
+      });
+  size_t best = partials[0];
+  for (size_t index : partials) {
+    if (cells[best] != cells[best]) break;
+    if (cells[index] < cells[best] || cells[index] != cells[index]) {
+      best = index;
+    }
+  }
+  return {static_cast<int>(best / cols_), static_cast<int>(best % cols_)};
+}
+
+// Returns the row and column of the first largest element in row-major order,
+// or of the first NaN when there is one
+std::pair<int, int> S21Matrix::ArgMax() const {
+  CheckIfNotEmpty();
+  const double *cells = matrix_[0];
+  std::vector<size_t> partials = ReduceChunks<size_t>(
+      static_cast<size_t>(rows_) * cols_,
+      [cells](size_t first, size_t number) {
+        return first + S21ArgMax(cells + first, number);
+      });
+  size_t best = partials[0];
+  for (size_t index : partials) {
+    if (cells[best] != cells[best]) break;
+    if (cells[index] > cells[best] || cells[index] != cells[index]) {
+      best = index;
+    }
+  }
+  return {static_cast<int>(best / cols_), static_cast<int>(best % cols_)};
+}
+
+// Returns the sum of the products of the corresponding elements (the
+// Frobenius inner product), the sizes must be equal
+double S21Matrix::Dot(const S21Matrix &other) const {
+  CheckIfSizesAreEqual(other);
+  if (rows_ < 1) return 0;
+  const double *x = matrix_[0], *y = other.matrix_[0];
+  std::vector<double> partials = ReduceChunks<double>(
+      static_cast<size_t>(rows_) * cols_,
+      [x, y](size_t first, size_t number) {
+        return S21PairwiseDot(x + first, y + first, number);
+      });
+  return S21Sum(partials.data(), partials.size());
+}
+
+// Returns the elementwise (Hadamard) product of the matrices
+S21Matrix S21Matrix::Hadamard(const S21Matrix &other) const {
+  S21Matrix result(*this);
+  result.HadamardInPlace(other);
+  return result;
+}
+
+// Multiplies every element by the corresponding element of other
+void S21Matrix::HadamardInPlace(const S21Matrix &other) {
+  ZipInPlace(
+      other, [](double x, double y) { return x * y; }, Execution::kParallel);
+}
+
+// Returns the elementwise quotient of the matrices
+S21Matrix S21Matrix::Divide(const S21Matrix &other) const {
+  S21Matrix result(*this);
+  result.DivideInPlace(other);
+  return result;
+}
+
+// Divides every element by the corresponding element of other. Division by
+// zero follows IEEE 754 and gives an infinity or NaN, as MulNumber does for
+// overflow
+void S21Matrix::DivideInPlace(const S21Matrix &other) {
+  ZipInPlace(
+      other, [](double x, double y) { return x / y; }, Execution::kParallel);
+}
+
 // Adds the given matrix to the current matrix
 void S21Matrix::SumMatrix(const S21Matrix &other) {
   CheckIfSizesAreEqual(other);
+  Detach();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] += other.matrix_[i][j];
     }
   }
+  Touch();
 }
 
 // Subtracts the given matrix from the current matrix
 void S21Matrix::SubMatrix(const S21Matrix &other) {
   CheckIfSizesAreEqual(other);
+  Detach();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] -= other.matrix_[i][j];
     }
   }
+  Touch();
+}
+
+// Adds the transpose of the viewed matrix to the current matrix
+void S21Matrix::SumMatrix(const S21TransposedView &other) {
+  AddTransposed(other, 1);
+}
+
+// Subtracts the transpose of the viewed matrix from the current matrix
+void S21Matrix::SubMatrix(const S21TransposedView &other) {
+  AddTransposed(other, -1);
+}
+
+// Adds sign * B^T tile by tile, so the rows of the current matrix and the
+// columns of B are both read within cache. A view of the matrix itself is
+// materialized first, since its elements would be overwritten before read
+void S21Matrix::AddTransposed(const S21TransposedView &other, double sign) {
+  if (rows_ != other.GetRows() || cols_ != other.GetCols()) {
+    throw std::invalid_argument("Rows or columns are not equal");
+  }
+  if (other.matrix_ == this) {
+    S21Matrix transposed = other.Materialize();
+    transposed.MulNumber(sign);
+    SumMatrix(transposed);
+    return;
+  }
+  Detach();
+  const double *const *b = other.matrix_->matrix_;
+  for (int ib = 0; ib < rows_; ib += kTransposeTile) {
+    const int ie = std::min(rows_, ib + kTransposeTile);
+    for (int jb = 0; jb < cols_; jb += kTransposeTile) {
+      const int je = std::min(cols_, jb + kTransposeTile);
+      for (int i = ib; i < ie; i++) {
+        for (int j = jb; j < je; j++) {
+          matrix_[i][j] += sign * b[j][i];
+        }
+      }
+    }
+  }
+  Touch();
 }
 
 // Checks if rows and cols is equal in two matrices
@@ -143,29 +645,125 @@ void S21Matrix::CheckIfSizesAreEqual(const S21Matrix &other) const {
 }
 
 // Multiplies the matrix by a number
-void S21Matrix::MulNumber(const double num) noexcept {
+void S21Matrix::MulNumber(const double num) {
+  Detach();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
       matrix_[i][j] *= num;
     }
   }
+  Touch();
 }
 
-// Multiplies two matrices
+// Multiplies two matrices with the blocked multithreaded kernel
 void S21Matrix::MulMatrix(const S21Matrix &other) {
   if (cols_ != other.rows_) {
     throw std::invalid_argument("Invalid sizes of matrices for multiplying");
   }
   S21Matrix res(rows_, other.cols_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      res(i, j) = 0;
-      for (int k = 0; k < cols_; k++) {
-        res(i, j) += matrix_[i][k] * other.matrix_[k][j];
-      }
+  S21Gemm(rows_, other.cols_, cols_, matrix_, other.matrix_, res.matrix_);
+  *this = std::move(res);
+}
+
+// Multiplies the matrix by the transpose of the viewed matrix
+void S21Matrix::MulMatrix(const S21TransposedView &other) {
+  *this = *this * other;
+}
+
+// Multiplies the matrix by the given one in the semiring. The tropical
+// products run the blocked kernel with min or max in place of the sum, the
+// boolean product packs both matrices into bits and gives 0 or 1
+void S21Matrix::MulMatrix(const S21Matrix &other, Semiring semiring) {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+  }
+  if (semiring == Semiring::kPlusTimes) {
+    MulMatrix(other);
+  } else if (semiring == Semiring::kBoolean) {
+    *this = (S21BitMatrix(*this) * S21BitMatrix(other)).ToMatrix();
+  } else {
+    const bool min = semiring == Semiring::kMinPlus;
+    const double zero = min ? S21MinPlus::kZero : S21MaxPlus::kZero;
+    S21Matrix res(rows_, other.cols_);
+    std::fill(res.matrix_[0],
+              res.matrix_[0] + static_cast<size_t>(rows_) * other.cols_, zero);
+    if (min) {
+      S21SemiringGemm<S21MinPlus>(rows_, other.cols_, cols_, matrix_,
+                                  other.matrix_, res.matrix_);
+    } else {
+      S21SemiringGemm<S21MaxPlus>(rows_, other.cols_, cols_, matrix_,
+                                  other.matrix_, res.matrix_);
     }
+    *this = std::move(res);
   }
-  *this = res;
+}
+
+// Returns the product of the matrix and the vector. Every element is the dot
+// product of one contiguous row with the vector, rows are split between threads
+S21Vector S21Matrix::MulVector(const S21Vector &vector) const {
+  if (cols_ != vector.size_) {
+    throw std::invalid_argument("Invalid sizes of matrix and vector");
+  }
+  S21Vector result(rows_);
+  const double *x = vector.data_;
+  double *y = result.data_;
+  double **a = matrix_;
+  const int cols = cols_;
+  const long long cells = static_cast<long long>(rows_) * cols_;
+  S21ThreadPool::Instance().ParallelFor(
+      0, rows_, cells < kParallelCells ? rows_ : 1,
+      [a, x, y, cols](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          y[i] = S21Dot(a[i], x, cols);
+        }
+      });
+  return result;
+}
+
+// Returns the product of the transposed matrix and the vector without forming
+// the transpose: rows of the matrix scaled by the vector elements are summed.
+// Every thread owns a slab of columns, so the result needs no reduction
+S21Vector S21Matrix::MulVectorTransposed(const S21Vector &vector) const {
+  if (rows_ != vector.size_) {
+    throw std::invalid_argument("Invalid sizes of matrix and vector");
+  }
+  S21Vector result(cols_);
+  const double *x = vector.data_;
+  double *y = result.data_;
+  double **a = matrix_;
+  const int rows = rows_;
+  const long long cells = static_cast<long long>(rows_) * cols_;
+  S21ThreadPool::Instance().ParallelFor(
+      0, cols_, cells < kParallelCells ? cols_ : kColumnGrain,
+      [a, x, y, rows](int begin, int end) {
+        for (int i = 0; i < rows; i++) {
+          S21Axpy(x[i], a[i] + begin, y + begin, end - begin);
+        }
+      });
+  return result;
+}
+
+// Adds the outer product alpha * x * y^T to the matrix, rows are split
+// between threads
+void S21Matrix::RankOneUpdate(double alpha, const S21Vector &x,
+                              const S21Vector &y) {
+  if (rows_ != x.size_ || cols_ != y.size_) {
+    throw std::invalid_argument("Invalid sizes of matrix and vectors");
+  }
+  Detach();
+  const double *column = x.data_;
+  const double *row = y.data_;
+  double **a = matrix_;
+  const int cols = cols_;
+  const long long cells = static_cast<long long>(rows_) * cols_;
+  S21ThreadPool::Instance().ParallelFor(
+      0, rows_, cells < kParallelCells ? rows_ : 1,
+      [a, alpha, column, row, cols](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          S21Axpy(alpha * column[i], row, a[i], cols);
+        }
+      });
+  Touch();
 }
 
 // Creates a transposed matrix from the current matrix and returns it
@@ -179,6 +777,311 @@ S21Matrix S21Matrix::Transpose() const {
   return transposed;
 }
 
+// Returns a transposed view of the matrix, nothing is copied
+S21TransposedView S21Matrix::T() const noexcept {
+  return S21TransposedView(*this);
+}
+
+// Returns the identity matrix of the given order, the empty matrix for order 0
+S21Matrix S21Matrix::Identity(int size) {
+  if (size == 0) return S21Matrix();
+  S21Matrix identity(size, size);
+  for (int i = 0; i < size; i++) {
+    identity.matrix_[i][i] = 1;
+  }
+  return identity;
+}
+
+// Places the matrices side by side, they must have the same number of rows
+S21Matrix S21Matrix::HStack(const std::vector<BlockRef> &blocks) {
+  if (blocks.empty()) return S21Matrix();
+  return Block({blocks});
+}
+
+// Places the matrices one under another, they must have the same number of
+// columns
+S21Matrix S21Matrix::VStack(const std::vector<BlockRef> &blocks) {
+  std::vector<std::vector<BlockRef>> rows;
+  rows.reserve(blocks.size());
+  for (const BlockRef &block : blocks) {
+    rows.push_back({block});
+  }
+  return Block(rows);
+}
+
+// Assembles a matrix from rows of blocks, e.g. Block({{a, b}, {c, d}}). The
+// blocks of a row must have the same number of rows and every row of blocks
+// the same total number of columns. The shape is found first, so the result is
+// allocated once, and every row of a block is copied with a single memcpy. A
+// grid without rows or with only empty blocks gives the empty matrix
+S21Matrix S21Matrix::Block(const std::vector<std::vector<BlockRef>> &blocks) {
+  int rows = 0, cols = -1;
+  for (const auto &block_row : blocks) {
+    if (block_row.empty()) {
+      throw std::invalid_argument("A row of blocks can't be empty");
+    }
+    const int height = block_row.front().matrix->rows_;
+    int width = 0;
+    for (const BlockRef &block : block_row) {
+      if (block.matrix->rows_ != height) {
+        throw std::invalid_argument(
+            "Blocks of one row must have the same number of rows");
+      }
+      width += block.matrix->cols_;
+    }
+    if (cols >= 0 && width != cols) {
+      throw std::invalid_argument(
+          "Rows of blocks must have the same number of columns");
+    }
+    cols = width;
+    rows += height;
+  }
+  if (rows == 0) return S21Matrix();
+  S21Matrix result(rows, cols);
+  int top = 0;
+  for (const auto &block_row : blocks) {
+    const int height = block_row.front().matrix->rows_;
+    for (int i = 0; i < height; i++) {
+      double *target = result.matrix_[top + i];
+      for (const BlockRef &block : block_row) {
+        const int width = block.matrix->cols_;
+        std::memcpy(target, block.matrix->matrix_[i], sizeof(double) * width);
+        target += width;
+      }
+    }
+    top += height;
+  }
+  return result;
+}
+
+// Multiplies a chain of matrices in the order with the fewest operations,
+// see S21MatrixChain
+S21Matrix S21Matrix::MultiplyChain(const std::vector<BlockRef> &factors) {
+  return S21MatrixChain(factors).Multiply();
+}
+
+// Returns the Kronecker product: block (i, j) of the result is a(i, j) * B.
+// A row of the result is a sequence of scaled copies of one row of B, which
+// vectorizes, and the rows are split between threads
+S21Matrix S21Matrix::Kronecker(const S21Matrix &other) const {
+  S21Matrix result(rows_ * other.rows_, cols_ * other.cols_);
+  const int p = other.rows_, q = other.cols_, n = cols_;
+  double **a = matrix_, **b = other.matrix_, **c = result.matrix_;
+  const long long cells = static_cast<long long>(result.rows_) * result.cols_;
+  S21ThreadPool::Instance().ParallelFor(
+      0, result.rows_, cells < kParallelCells ? result.rows_ : 16,
+      [a, b, c, p, q, n](int begin, int end) {
+        for (int row = begin; row < end; row++) {
+          const double *source = b[row % p];
+          double *target = c[row];
+          for (int j = 0; j < n; j++, target += q) {
+            const double factor = a[row / p][j];
+            for (int t = 0; t < q; t++) {
+              target[t] = factor * source[t];
+            }
+          }
+        }
+      });
+  return result;
+}
+
+// Adds alpha * other to the matrix, the sizes must be equal. Rows are split
+// between threads for large matrices
+void S21Matrix::Accumulate(double alpha, const S21Matrix &other) {
+  Detach();
+  double **y = matrix_, **x = other.matrix_;
+  const int cols = cols_;
+  const long long cells = static_cast<long long>(rows_) * cols_;
+  S21ThreadPool::Instance().ParallelFor(
+      0, rows_, cells < kParallelCells ? rows_ : kPlacementGrain,
+      [alpha, x, y, cols](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+          S21Axpy(alpha, x[i], y[i], cols);
+        }
+      });
+  Touch();
+}
+
+// Adds alpha * other to the matrix in one pass (AXPY), no temporary is made
+void S21Matrix::AddScaled(const S21Matrix &other, double alpha) {
+  CheckIfSizesAreEqual(other);
+  Accumulate(alpha, other);
+}
+
+// Adds the product a * b to the matrix, the blocked kernel accumulates
+// straight into it
+void S21Matrix::MulAdd(const S21Matrix &a, const S21Matrix &b) {
+  Gemm(1.0, a, b, 1.0, *this);
+}
+
+// C = alpha * A * B + beta * C. C is scaled by beta in one pass, then the
+// blocked kernel adds the scaled product into it, so no temporary is made.
+// As in BLAS, beta = 0 clears C, so NaN and infinities in the old contents
+// don't survive. Only when C is one of the operands does the product go to a
+// temporary, which is added after C is scaled
+void S21Matrix::Gemm(double alpha, const S21Matrix &a, const S21Matrix &b,
+                     double beta, S21Matrix &c) {
+  if (a.cols_ != b.rows_ || c.rows_ != a.rows_ || c.cols_ != b.cols_) {
+    throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+  }
+  c.Detach();
+  const bool aliased =
+      c.matrix_ && (c.matrix_ == a.matrix_ || c.matrix_ == b.matrix_);
+  S21Matrix product;
+  if (aliased) {
+    product = S21Matrix(c.rows_, c.cols_);
+    S21Gemm(a.rows_, b.cols_, a.cols_, a.matrix_, b.matrix_, product.matrix_,
+            alpha);
+  }
+  if (beta == 0 && c.matrix_) {
+    std::fill(c.matrix_[0],
+              c.matrix_[0] + static_cast<size_t>(c.rows_) * c.cols_, 0.0);
+  } else if (beta != 1) {
+    c.MulNumber(beta);
+  }
+  if (aliased) {
+    c.Accumulate(1.0, product);
+    return;
+  }
+  S21Gemm(a.rows_, b.cols_, a.cols_, a.matrix_, b.matrix_, c.matrix_, alpha);
+  c.Touch();
+}
+
+// Replaces the square matrix by its square. The product is accumulated in the
+// scratch matrix of the same size, which then swaps places with the matrix
+void S21Matrix::SquareInPlace(S21Matrix &scratch) {
+  scratch.Detach();
+  std::fill(scratch.matrix_[0],
+            scratch.matrix_[0] + static_cast<size_t>(rows_) * cols_, 0.0);
+  S21Gemm(rows_, rows_, rows_, matrix_, matrix_, scratch.matrix_);
+  std::swap(*this, scratch);
+  Touch();
+}
+
+// Raises the matrix to an integer power by repeated squaring, reading the bits
+// of the exponent from the highest. The base is only read, so the result and
+// one scratch buffer that swaps places with it serve any power. Negative
+// powers raise the inverse. Any power of the empty matrix is empty
+S21Matrix S21Matrix::Pow(int power) const {
+  CheckIfSquare();
+  const int n = rows_;
+  if (n < 1) return S21Matrix();
+  if (power == 0) return Identity(n);
+  const S21Matrix inverse = power < 0 ? InverseMatrix() : S21Matrix();
+  const S21Matrix &base = power < 0 ? inverse : *this;
+  const unsigned long long exponent =
+      power < 0 ? -static_cast<long long>(power) : power;
+  if (exponent == 1) return base;
+  // The highest bit stands for the base itself, the first squaring of it
+  // goes straight into the result
+  int bit = 62 - __builtin_clzll(exponent);
+  S21Matrix result(n, n), scratch(n, n);
+  S21Gemm(n, n, n, base.matrix_, base.matrix_, result.matrix_);
+  for (;;) {
+    if ((exponent >> bit) & 1) {
+      std::fill(scratch.matrix_[0],
+                scratch.matrix_[0] + static_cast<size_t>(n) * n, 0.0);
+      S21Gemm(n, n, n, result.matrix_, base.matrix_, scratch.matrix_);
+      std::swap(result, scratch);
+    }
+    if (bit-- == 0) break;
+    result.SquareInPlace(scratch);
+  }
+  result.Touch();
+  return result;
+}
+
+// Returns the matrix exponential by scaling and squaring with the Pade
+// approximants of Higham (2005). The lowest degree accurate to double
+// precision for the 1-norm of the matrix is used. Matrices too large even for
+// degree 13 are divided by 2^s, and the exponential is squared s times. The
+// exponential of the empty matrix is empty, a matrix with an infinite or NaN
+// element gives a matrix of NaN
+S21Matrix S21Matrix::Expm() const {
+  CheckIfSquare();
+  if (rows_ < 1) return S21Matrix();
+  // Largest 1-norms for which the approximants of degree 3, 5, 7, 9 and 13
+  // are accurate to double precision
+  static constexpr double kTheta[] = {1.495585217958292e-2,
+                                      2.539398330063230e-1,
+                                      9.504178996162932e-1,
+                                      2.097847961257068, 5.371920351148152};
+  static constexpr int kDegree[] = {3, 5, 7, 9, 13};
+  static constexpr double kCoefficients[][14] = {
+      {120, 60, 12, 1},
+      {30240, 15120, 3360, 420, 30, 1},
+      {17297280, 8648640, 1995840, 277200, 25200, 1512, 56, 1},
+      {17643225600, 8821612800, 2075673600, 302702400, 30270240, 2162160,
+       110880, 3960, 90, 1},
+      {64764752532480000, 32382376266240000, 7771770303897600,
+       1187353796428800, 129060195264000, 10559470521600, 670442572800,
+       33522128640, 1323241920, 40840800, 960960, 16380, 182, 1}};
+  const int n = rows_;
+  const double norm = Norm(NormType::kOne);
+  if (!std::isfinite(norm)) {
+    S21Matrix undefined(n, n);
+    std::fill(undefined.matrix_[0],
+              undefined.matrix_[0] + static_cast<size_t>(n) * n,
+              std::numeric_limits<double>::quiet_NaN());
+    return undefined;
+  }
+  int degree = 4, squarings = 0;
+  for (int d = 0; d < 4; d++) {
+    if (norm <= kTheta[d]) {
+      degree = d;
+      break;
+    }
+  }
+  S21Matrix a(*this);
+  if (degree == 4 && norm > kTheta[4]) {
+    squarings = static_cast<int>(ceil(log2(norm / kTheta[4])));
+    a.MulNumber(ldexp(1.0, -squarings));
+  }
+  const double *b = kCoefficients[degree];
+  const S21Matrix identity = Identity(n);
+  S21Matrix u(n, n), v(n, n);
+  const S21Matrix a2 = a * a;
+  if (kDegree[degree] < 13) {
+    // U = A * sum b[2j + 1] A^2j, V = sum b[2j] A^2j
+    S21Matrix power = identity;
+    for (int j = 0; 2 * j < kDegree[degree]; j++) {
+      if (j > 0) power.MulMatrix(a2);
+      u.Accumulate(b[2 * j + 1], power);
+      v.Accumulate(b[2 * j], power);
+    }
+  } else {
+    const S21Matrix a4 = a2 * a2, a6 = a4 * a2;
+    S21Matrix high(n, n);
+    high.Accumulate(b[13], a6);
+    high.Accumulate(b[11], a4);
+    high.Accumulate(b[9], a2);
+    u = a6 * high;
+    u.Accumulate(b[7], a6);
+    u.Accumulate(b[5], a4);
+    u.Accumulate(b[3], a2);
+    u.Accumulate(b[1], identity);
+    high = S21Matrix(n, n);
+    high.Accumulate(b[12], a6);
+    high.Accumulate(b[10], a4);
+    high.Accumulate(b[8], a2);
+    v = a6 * high;
+    v.Accumulate(b[6], a6);
+    v.Accumulate(b[4], a4);
+    v.Accumulate(b[2], a2);
+    v.Accumulate(b[0], identity);
+  }
+  u = a * u;
+  // exp(A) = (V - U)^-1 (V + U)
+  S21Matrix numerator = v + u;
+  v.SubMatrix(u);
+  S21Matrix result = v.Solve(numerator);
+  S21Matrix scratch(n, n);
+  for (int i = 0; i < squarings; i++) {
+    result.SquareInPlace(scratch);
+  }
+  return result;
+}
+
 // Calculates the matrix of cofactors of the current matrix and returns it
 S21Matrix S21Matrix::CalcComplements() const {
   CheckIfSquare();
@@ -198,6 +1101,33 @@ void S21Matrix::CheckIfSquare() const {
   }
 }
 
+// Calls body(first, last) for ranges covering the cells of the block. Large
+// matrices in parallel execution are split into chunks of the reductions,
+// the caller does the rest in one call
+void S21Matrix::ForEachChunk(
+    Execution execution,
+    const std::function<void(size_t, size_t)> &body) const {
+  const size_t cells = static_cast<size_t>(rows_) * cols_;
+  if (execution == Execution::kSequential ||
+      static_cast<long long>(cells) < kParallelCells) {
+    body(0, cells);
+    return;
+  }
+  const int chunks =
+      static_cast<int>((cells + kReduceChunk - 1) / kReduceChunk);
+  S21ThreadPool::Instance().ParallelFor(
+      0, chunks, 1, [&body, cells](int begin, int end) {
+        body(begin * kReduceChunk, std::min(cells, end * kReduceChunk));
+      });
+}
+
+// Checks if the matrix has cells
+void S21Matrix::CheckIfNotEmpty() const {
+  if (rows_ < 1 || cols_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+}
+
 // Helper function for finding the matrix of cofactors
 void S21Matrix::ComplementsHelp(S21Matrix &complements) const {
   for (int i = 0; i < rows_; i++) {
@@ -227,10 +1157,28 @@ void S21Matrix::FindMinor(S21Matrix &minor, int row, int col) const noexcept {
   }
 }
 
-// Finds the determinant of the matrix and returns it
+// Finds the determinant of the matrix and returns it, the result is cached
+// until the matrix is modified. The empty matrix has the determinant 0, as it
+// always had, although it is triangular
 double S21Matrix::Determinant() const {
   CheckIfSquare();
-  return DetHelp();
+  if (rows_ < 1) return 0;
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  DerivedCache &cache = ValidCache();
+  if (!cache.determinant) {
+    if (IsUpperTriangular() || IsLowerTriangular()) {
+      // The product of the diagonal, no factorization is needed
+      double product = 1;
+      for (int i = 0; i < rows_; i++) {
+        product *= matrix_[i][i];
+      }
+      cache.determinant = product;
+    } else {
+      cache.determinant =
+          rows_ <= kCofactorMaxSize ? DetHelp() : CachedLU().Determinant();
+    }
+  }
+  return *cache.determinant;
 }
 
 // Recursive function for calculating the determinant of the matrix, returns the
@@ -250,47 +1198,250 @@ double S21Matrix::DetHelp() const {
   return total;
 }
 
-// Creates the inverse matrix of the current matrix and returns it
+// Creates the inverse matrix of the current matrix and returns it, the result
+// is cached until the matrix is modified
 S21Matrix S21Matrix::InverseMatrix() const {
   const double determinant = Determinant();
   // 1.0e-07 is 10 * 10 ^ (-7)
   if (fabs(determinant) <= 1.0e-7) {
     throw std::logic_error("Matrix determinant can't be 0");
   }
-  S21Matrix inversed = CalcComplements();
-  inversed = inversed.Transpose();
-  inversed *= (1.0 / determinant);
-  return inversed;
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  DerivedCache &cache = ValidCache();
+  if (!cache.inverse) {
+    S21Matrix inversed;
+    if (rows_ <= kCofactorMaxSize) {
+      inversed = CalcComplements().Transpose();
+      inversed.MulNumber(1.0 / determinant);
+    } else {
+      inversed = CachedLU().Inverse();
+    }
+    cache.inverse = std::make_shared<const S21Matrix>(std::move(inversed));
+  }
+  return *cache.inverse;
+}
+
+// Returns the LU factorization of the matrix, the factorization is cached until
+// the matrix is modified
+S21LU S21Matrix::Factorize() const { return CachedLU(); }
+
+// Solves the system A * X = rhs for every column of rhs with the cached LU
+// factorization and returns X
+S21Matrix S21Matrix::Solve(const S21Matrix &rhs) const {
+  return CachedLU().Solve(rhs);
+}
+
+// Returns the LL^T Cholesky factorization of the matrix, check its
+// IsPositiveDefinite() before use. The factorization is cached until the
+// matrix is modified
+S21Cholesky S21Matrix::Cholesky() const {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  DerivedCache &cache = ValidCache();
+  if (!cache.cholesky) {
+    cache.cholesky =
+        std::make_shared<const S21Cholesky>(*this, S21Cholesky::Kind::kLLT);
+  }
+  return *cache.cholesky;
+}
+
+// Returns the LDL^T Cholesky factorization of the matrix, check its
+// IsPositiveDefinite() before use. The factorization is cached until the
+// matrix is modified
+S21Cholesky S21Matrix::CholeskyLDLT() const {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  DerivedCache &cache = ValidCache();
+  if (!cache.ldlt) {
+    cache.ldlt =
+        std::make_shared<const S21Cholesky>(*this, S21Cholesky::Kind::kLDLT);
+  }
+  return *cache.ldlt;
+}
+
+// Returns the Householder QR factorization of the matrix, the factorization is
+// cached until the matrix is modified
+S21QR S21Matrix::QR() const {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  DerivedCache &cache = ValidCache();
+  if (!cache.qr) {
+    cache.qr = std::make_shared<const S21QR>(*this);
+  }
+  return *cache.qr;
+}
+
+// Returns the eigenvalues and, if asked for, the eigenvectors of the matrix,
+// which must be symmetric
+S21SymmetricEigen S21Matrix::EigenSymmetric(bool vectors) const {
+  return S21SymmetricEigen(*this, vectors);
+}
+
+// Returns the singular value decomposition of the matrix, the decomposition
+// is cached until the matrix is modified
+S21SVD S21Matrix::SVD() const {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  DerivedCache &cache = ValidCache();
+  if (!cache.svd) {
+    cache.svd = std::make_shared<const S21SVD>(*this);
+  }
+  return *cache.svd;
+}
+
+// Solves the system A * X = rhs with a single precision factorization refined
+// to double precision accuracy, falling back to the double precision LU for
+// ill-conditioned matrices. The factorization is cached until the matrix is
+// modified. The lock is held only while the factorization is looked up, so
+// solves with one matrix run in parallel
+S21Matrix S21Matrix::SolveMixed(const S21Matrix &rhs) const {
+  std::shared_ptr<const S21MixedLU> solver;
+  {
+    std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+    DerivedCache &cache = ValidCache();
+    if (!cache.mixed_lu) {
+      cache.mixed_lu = std::make_shared<const S21MixedLU>(*this);
+    }
+    solver = cache.mixed_lu;
+  }
+  return solver->Solve(rhs);
+}
+
+// Multiplies a snapshot of the matrices on the thread pool, band of rows by
+// band of rows
+std::future<S21Matrix> S21Matrix::MulMatrixAsync(
+    const S21Matrix &other, S21CancellationToken token,
+    S21ProgressCallback progress) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+  }
+  return S21RunAsync([left = *this, right = other, token, progress] {
+    S21Matrix result(left.rows_, right.cols_);
+    for (int begin = 0; begin < left.rows_; begin += kAsyncStep) {
+      token.ThrowIfCancelled();
+      const int rows = std::min(kAsyncStep, left.rows_ - begin);
+      S21Gemm(rows, right.cols_, left.cols_, left.matrix_ + begin,
+              right.matrix_, result.matrix_ + begin);
+      if (progress) progress(static_cast<double>(begin + rows) / left.rows_);
+    }
+    return result;
+  });
+}
+
+// Inverts a snapshot of the matrix on the thread pool: the LU factorization
+// is one step, then the columns of the inverse are solved band by band
+std::future<S21Matrix> S21Matrix::InverseAsync(
+    S21CancellationToken token, S21ProgressCallback progress) const {
+  CheckIfSquare();
+  return S21RunAsync([matrix = *this, token, progress] {
+    token.ThrowIfCancelled();
+    const int n = matrix.rows_;
+    if (n <= kCofactorMaxSize || matrix.ValidCache().inverse) {
+      S21Matrix inverse = matrix.InverseMatrix();
+      if (progress) progress(1);
+      return inverse;
+    }
+    // 1.0e-07 is 10 * 10 ^ (-7)
+    if (fabs(matrix.Determinant()) <= 1.0e-7) {
+      throw std::logic_error("Matrix determinant can't be 0");
+    }
+    const S21LU &lu = matrix.CachedLU();
+    if (progress) progress(kFactorizationShare);
+    S21Matrix inverse(n, n);
+    for (int begin = 0; begin < n; begin += kAsyncStep) {
+      token.ThrowIfCancelled();
+      const int cols = std::min(kAsyncStep, n - begin);
+      S21Matrix identity(n, cols);
+      for (int j = 0; j < cols; j++) {
+        identity.matrix_[begin + j][j] = 1;
+      }
+      const S21Matrix band = lu.Solve(identity);
+      for (int i = 0; i < n; i++) {
+        std::copy(band.matrix_[i], band.matrix_[i] + cols,
+                  inverse.matrix_[i] + begin);
+      }
+      if (progress) {
+        progress(kFactorizationShare + (1 - kFactorizationShare) *
+                                           (begin + cols) / n);
+      }
+    }
+    return inverse;
+  });
+}
+
+// Finds the determinant of a snapshot of the matrix on the thread pool, the
+// factorization is a single step
+std::future<double> S21Matrix::DeterminantAsync(
+    S21CancellationToken token, S21ProgressCallback progress) const {
+  CheckIfSquare();
+  return S21RunAsync([matrix = *this, token, progress] {
+    token.ThrowIfCancelled();
+    const double determinant = matrix.Determinant();
+    if (progress) progress(1);
+    return determinant;
+  });
+}
+
+// Returns the cached LU factorization, factorizing the matrix if needed
+const S21LU &S21Matrix::CachedLU() const {
+  std::lock_guard<std::recursive_mutex> lock(cache_mutex_);
+  DerivedCache &cache = ValidCache();
+  if (!cache.lu) {
+    cache.lu = std::make_shared<const S21LU>(*this);
+  }
+  return *cache.lu;
 }
 
 // Returns the sum of the current matrix and the given matrix
-S21Matrix S21Matrix::operator+(const S21Matrix &other) {
+S21Matrix S21Matrix::operator+(const S21Matrix &other) const {
   S21Matrix result(*this);
   result.SumMatrix(other);
   return result;
 }
 
 // Returns the difference between the current matrix and the given matrix
-S21Matrix S21Matrix::operator-(const S21Matrix &other) {
+S21Matrix S21Matrix::operator-(const S21Matrix &other) const {
   S21Matrix result(*this);
   result.SubMatrix(other);
   return result;
 }
 
 // Returns the product of the current matrix and the given matrix
-S21Matrix S21Matrix::operator*(const S21Matrix &other) {
+S21Matrix S21Matrix::operator*(const S21Matrix &other) const {
   S21Matrix result(*this);
   result.MulMatrix(other);
   return result;
 }
 
 // Returns the product of the current matrix and a number
-S21Matrix S21Matrix::operator*(const double mul) {
+S21Matrix S21Matrix::operator*(const double mul) const {
   S21Matrix result(*this);
   result.MulNumber(mul);
   return result;
 }
 
+// Returns the sum of the current matrix and the transpose of the viewed matrix
+S21Matrix S21Matrix::operator+(const S21TransposedView &other) const {
+  S21Matrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+// Returns the difference between the current matrix and the transpose of the
+// viewed matrix
+S21Matrix S21Matrix::operator-(const S21TransposedView &other) const {
+  S21Matrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+// Returns A * B^T, every element is the dot product of two contiguous rows
+S21Matrix S21Matrix::operator*(const S21TransposedView &other) const {
+  if (cols_ != other.GetRows()) {
+    throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+  }
+  const S21Matrix &b = *other.matrix_;
+  S21Matrix result(rows_, b.rows_);
+  S21GemmNT(rows_, b.rows_, cols_, matrix_, b.matrix_, result.matrix_);
+  return result;
+}
+
 // Checks if the matrices are equal
 bool S21Matrix::operator==(const S21Matrix &other) const noexcept {
   return EqMatrix(other);
@@ -304,7 +1455,10 @@ S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
   ClearMatrix();
   rows_ = other.rows_;
   cols_ = other.cols_;
-  CopyMatrix(other);
+  if (!ShareMatrix(other)) {
+    CopyMatrix(other);
+  }
+  AdoptCache(other);
   return *this;
 }
 
@@ -313,9 +1467,13 @@ S21Matrix &S21Matrix::operator=(S21Matrix &&other) {
   if (this == &other) {
     return *this;
   }
+  ClearMatrix();
   rows_ = std::exchange(other.rows_, 0);
   cols_ = std::exchange(other.cols_, 0);
   matrix_ = std::exchange(other.matrix_, nullptr);
+  references_ = std::exchange(other.references_, nullptr);
+  version_ = other.version_.exchange(0);
+  cache_ = std::exchange(other.cache_, {});
   return *this;
 }
 
@@ -343,18 +1501,97 @@ S21Matrix S21Matrix::operator*=(const double mul) {
   return *this;
 }
 
-// Returns a pointer to the value of the matrix at the specified row and column
-double &S21Matrix::operator()(int row, int col) {
+// Returns the cell of the matrix at the specified row and column, writes
+// through it are seen by the version and by copy-on-write
+S21Matrix::CellRef S21Matrix::operator()(int row, int col) {
   CheckIfIndexExists(row, col);
-  return matrix_[row][col];
+  return CellRef(this, row, col);
 }
 
-// Returns a pointer to the value of the matrix at the specified row and column
-double &S21Matrix::operator()(int row, int col) const {
+// Returns a read-only pointer to the value of the matrix at the specified row
+// and column
+const double &S21Matrix::operator()(int row, int col) const {
   CheckIfIndexExists(row, col);
   return matrix_[row][col];
 }
 
+// Creates a writable cell of the matrix, the indices are already checked
+S21Matrix::CellRef::CellRef(S21Matrix *matrix, int row, int col) noexcept
+    : matrix_(matrix), row_(row), col_(col) {}
+
+// Returns the value of the cell
+S21Matrix::CellRef::operator double() const noexcept {
+  return matrix_->matrix_[row_][col_];
+}
+
+// Gives the matrix cells of its own, marks it as modified and returns the
+// cell to be written
+double &S21Matrix::CellRef::Write() {
+  matrix_->Detach();
+  matrix_->Touch();
+  return matrix_->matrix_[row_][col_];
+}
+
+// Writes the value into the cell
+S21Matrix::CellRef &S21Matrix::CellRef::operator=(double value) {
+  Write() = value;
+  return *this;
+}
+
+// Writes the value of another cell into the cell
+S21Matrix::CellRef &S21Matrix::CellRef::operator=(const CellRef &other) {
+  return *this = static_cast<double>(other);
+}
+
+// Adds the value to the cell
+S21Matrix::CellRef &S21Matrix::CellRef::operator+=(double value) {
+  Write() += value;
+  return *this;
+}
+
+// Subtracts the value from the cell
+S21Matrix::CellRef &S21Matrix::CellRef::operator-=(double value) {
+  Write() -= value;
+  return *this;
+}
+
+// Multiplies the cell by the value
+S21Matrix::CellRef &S21Matrix::CellRef::operator*=(double value) {
+  Write() *= value;
+  return *this;
+}
+
+// Divides the cell by the value
+S21Matrix::CellRef &S21Matrix::CellRef::operator/=(double value) {
+  Write() /= value;
+  return *this;
+}
+
+// Increments the cell
+S21Matrix::CellRef &S21Matrix::CellRef::operator++() {
+  ++Write();
+  return *this;
+}
+
+// Decrements the cell
+S21Matrix::CellRef &S21Matrix::CellRef::operator--() {
+  --Write();
+  return *this;
+}
+
+// Increments the cell and returns its old value
+double S21Matrix::CellRef::operator++(int) { return Write()++; }
+
+// Decrements the cell and returns its old value
+double S21Matrix::CellRef::operator--(int) { return Write()--; }
+
+// Swaps the values of two cells, found by argument-dependent lookup
+void swap(S21Matrix::CellRef a, S21Matrix::CellRef b) {
+  const double value = a;
+  a = b;
+  b = value;
+}
+
 // Checks if indeces is valid for matrix
 void S21Matrix::CheckIfIndexExists(int row, int col) const {
   if (row < 0) {
@@ -367,3 +1604,57 @@ void S21Matrix::CheckIfIndexExists(int row, int col) const {
     throw std::out_of_range("Column doesn't exist");
   }
 }
+
+// Creates a view of the transpose of the given matrix
+S21TransposedView::S21TransposedView(const S21Matrix &matrix) noexcept
+    : matrix_(&matrix) {}
+
+// Returns the number of rows of the transpose
+int S21TransposedView::GetRows() const noexcept { return matrix_->cols_; }
+
+// Returns the number of columns of the transpose
+int S21TransposedView::GetCols() const noexcept { return matrix_->rows_; }
+
+// Returns the viewed matrix
+const S21Matrix &S21TransposedView::GetMatrix() const noexcept {
+  return *matrix_;
+}
+
+// Returns the transpose as a new matrix
+S21Matrix S21TransposedView::Materialize() const {
+  return matrix_->Transpose();
+}
+
+// Returns A^T * x with the kernel that sums scaled rows of A
+S21Vector S21TransposedView::MulVector(const S21Vector &vector) const {
+  return matrix_->MulVectorTransposed(vector);
+}
+
+// Returns the sum of the transpose and the given matrix
+S21Matrix S21TransposedView::operator+(const S21Matrix &other) const {
+  return other + *this;
+}
+
+// Returns A^T * B, the columns of A are read as rows of the product
+S21Matrix S21TransposedView::operator*(const S21Matrix &other) const {
+  if (GetCols() != other.rows_) {
+    throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+  }
+  S21Matrix result(GetRows(), other.cols_);
+  S21GemmTN(GetRows(), other.cols_, matrix_->rows_, matrix_->matrix_,
+            other.matrix_, result.matrix_);
+  return result;
+}
+
+// Returns A^T * B^T as the transpose of B * A
+S21Matrix S21TransposedView::operator*(const S21TransposedView &other) const {
+  if (GetCols() != other.GetRows()) {
+    throw std::invalid_argument("Invalid sizes of matrices for multiplying");
+  }
+  return (*other.matrix_ * *matrix_).Transpose();
+}
+
+// Returns the element of the transpose at the specified row and column
+double S21TransposedView::operator()(int row, int col) const {
+  return (*matrix_)(col, row);
+}
@@ -1,12 +1,95 @@
 #ifndef S21_MATRIX_OOP_H
 #define S21_MATRIX_OOP_H
 
+#include <atomic>
 #include <cmath>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <utility>
+#include <vector>
+
+#include "s21_async.h"
+
+class S21BitMatrix;
+class S21Cholesky;
+class S21LU;
+class S21MatrixChain;
+class S21MixedLU;
+class S21QR;
+class S21SVD;
+class S21SymmetricEigen;
+class S21SymmetricMatrix;
+class S21TransposedView;
+class S21TriangularMatrix;
+class S21Vector;
 
 class S21Matrix {
+  friend class S21BitMatrix;
+  friend class S21Cholesky;
+  friend class S21LU;
+  friend class S21MatrixChain;
+  friend class S21MixedLU;
+  friend class S21QR;
+  friend class S21SVD;
+  friend class S21SymmetricEigen;
+  friend class S21SymmetricMatrix;
+  friend class S21TransposedView;
+  friend class S21TriangularMatrix;
+  friend class S21Vector;
+
  public:
+  // Block of HStack, VStack or Block. Temporaries bind to it too, they live
+  // until the assembled matrix is returned
+  struct BlockRef {
+    BlockRef(const S21Matrix& block) noexcept : matrix(&block) {}
+    const S21Matrix* matrix;
+  };
+
+  // Writable cell returned by the non-const operator(). Every write through it
+  // gives the matrix cells of its own and marks it as modified, so copies
+  // sharing the cells and cached derived results never see the write, also
+  // when the cell is kept and written later
+  class CellRef {
+    friend class S21Matrix;
+
+   public:
+    operator double() const noexcept;
+    CellRef& operator=(double value);
+    CellRef& operator=(const CellRef& other);
+    CellRef& operator+=(double value);
+    CellRef& operator-=(double value);
+    CellRef& operator*=(double value);
+    CellRef& operator/=(double value);
+    CellRef& operator++();
+    CellRef& operator--();
+    double operator++(int);
+    double operator--(int);
+    friend void swap(CellRef a, CellRef b);
+
+   private:
+    CellRef(S21Matrix* matrix, int row, int col) noexcept;
+    double& Write();
+
+    S21Matrix* matrix_;
+    int row_, col_;
+  };
+
+  // Matrix norms: square root of the sum of squares, largest column and row
+  // sums of absolute values, largest absolute value
+  enum class NormType { kFrobenius, kOne, kInf, kMax };
+
+  // Execution of elementwise operations: on the calling thread, or split
+  // between the threads of the pool for large matrices
+  enum class Execution { kSequential, kParallel };
+
+  // Semirings of products: the usual (+, *), the tropical (min, +) and
+  // (max, +), and the boolean (or, and) on nonzero elements
+  enum class Semiring { kPlusTimes, kMinPlus, kMaxPlus, kBoolean };
+
   /* ===================== Constructors and destructors ===================== */
   S21Matrix() noexcept;
   S21Matrix(int rows, int cols);
@@ -17,25 +100,94 @@ class S21Matrix {
   /* ======================== Accessors and mutatos ========================= */
   int GetRows() const noexcept;
   int GetCols() const noexcept;
+  unsigned long long GetVersion() const noexcept;
+  static void SetCopyOnWrite(bool enabled) noexcept;
+  static bool GetCopyOnWrite() noexcept;
+  bool IsShared() const noexcept;
+  static S21Matrix Identity(int size);
+  static S21Matrix HStack(const std::vector<BlockRef>& blocks);
+  static S21Matrix VStack(const std::vector<BlockRef>& blocks);
+  static S21Matrix Block(const std::vector<std::vector<BlockRef>>& blocks);
+  static S21Matrix MultiplyChain(const std::vector<BlockRef>& factors);
   void SetRows(int rows);
   void SetCols(int cols);
 
   /* ============================== Functions =============================== */
   bool EqMatrix(const S21Matrix& other) const noexcept;
+  bool IsLowerTriangular() const noexcept;
+  bool IsUpperTriangular() const noexcept;
+  double Trace() const;
+  double Norm(NormType type = NormType::kFrobenius) const;
+  double Sum() const;
+  double Min() const;
+  double Max() const;
+  std::pair<int, int> ArgMin() const;
+  std::pair<int, int> ArgMax() const;
+  double Dot(const S21Matrix& other) const;
+  template <typename Function>
+  S21Matrix Apply(Function function,
+                  Execution execution = Execution::kSequential) const;
+  template <typename Function>
+  void ApplyInPlace(Function function,
+                    Execution execution = Execution::kSequential);
+  template <typename Function>
+  S21Matrix Zip(const S21Matrix& other, Function function,
+                Execution execution = Execution::kSequential) const;
+  template <typename Function>
+  void ZipInPlace(const S21Matrix& other, Function function,
+                  Execution execution = Execution::kSequential);
+  S21Matrix Hadamard(const S21Matrix& other) const;
+  void HadamardInPlace(const S21Matrix& other);
+  S21Matrix Divide(const S21Matrix& other) const;
+  void DivideInPlace(const S21Matrix& other);
   void SumMatrix(const S21Matrix& other);
+  void SumMatrix(const S21TransposedView& other);
   void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num) noexcept;
+  void SubMatrix(const S21TransposedView& other);
+  void MulNumber(const double num);
   void MulMatrix(const S21Matrix& other);
+  void MulMatrix(const S21TransposedView& other);
+  void MulMatrix(const S21Matrix& other, Semiring semiring);
+  S21Vector MulVector(const S21Vector& vector) const;
+  S21Vector MulVectorTransposed(const S21Vector& vector) const;
+  void RankOneUpdate(double alpha, const S21Vector& x, const S21Vector& y);
+  void AddScaled(const S21Matrix& other, double alpha);
+  void MulAdd(const S21Matrix& a, const S21Matrix& b);
+  static void Gemm(double alpha, const S21Matrix& a, const S21Matrix& b,
+                   double beta, S21Matrix& c);
   S21Matrix Transpose() const;
+  S21TransposedView T() const noexcept;
+  S21Matrix Pow(int power) const;
+  S21Matrix Expm() const;
+  S21Matrix Kronecker(const S21Matrix& other) const;
   S21Matrix CalcComplements() const;
   double Determinant() const;
   S21Matrix InverseMatrix() const;
+  S21LU Factorize() const;
+  S21Matrix Solve(const S21Matrix& rhs) const;
+  S21Matrix SolveMixed(const S21Matrix& rhs) const;
+  S21Cholesky Cholesky() const;
+  S21Cholesky CholeskyLDLT() const;
+  S21QR QR() const;
+  S21SymmetricEigen EigenSymmetric(bool vectors = true) const;
+  S21SVD SVD() const;
+  std::future<S21Matrix> MulMatrixAsync(
+      const S21Matrix& other, S21CancellationToken token = {},
+      S21ProgressCallback progress = {}) const;
+  std::future<S21Matrix> InverseAsync(S21CancellationToken token = {},
+                                      S21ProgressCallback progress = {}) const;
+  std::future<double> DeterminantAsync(
+      S21CancellationToken token = {},
+      S21ProgressCallback progress = {}) const;
 
   /* ============================== Operators =============================== */
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(const double mul);
+  S21Matrix operator+(const S21Matrix& other) const;
+  S21Matrix operator-(const S21Matrix& other) const;
+  S21Matrix operator*(const S21Matrix& other) const;
+  S21Matrix operator*(const double mul) const;
+  S21Matrix operator+(const S21TransposedView& other) const;
+  S21Matrix operator-(const S21TransposedView& other) const;
+  S21Matrix operator*(const S21TransposedView& other) const;
   bool operator==(const S21Matrix& other) const noexcept;
   S21Matrix& operator=(const S21Matrix& other);
   S21Matrix& operator=(S21Matrix&& other);
@@ -43,25 +195,151 @@ class S21Matrix {
   S21Matrix operator-=(const S21Matrix& other);
   S21Matrix operator*=(const S21Matrix& other);
   S21Matrix operator*=(const double mul);
-  double& operator()(int row, int col);
-  double& operator()(int row, int col) const;
+  CellRef operator()(int row, int col);
+  const double& operator()(int row, int col) const;
 
  private:
   /* ============================= Attributes =============================== */
   int rows_, cols_;
   double** matrix_;
+  // Number of matrices sharing the cells in copy-on-write mode, nullptr while
+  // the cells were never shared. Created by the first copy under the cache
+  // lock of the source
+  mutable std::atomic<long>* references_;
+  // Reset to zero by every mutator, a new number is taken when the version is
+  // asked for next. Derived results are valid only for the version they were
+  // computed for
+  mutable std::atomic<unsigned long long> version_;
+
+  // Lazily computed results derived from the matrix contents
+  struct DerivedCache {
+    unsigned long long version = 0;
+    std::optional<double> determinant;
+    // Norms indexed by NormType
+    std::optional<double> norms[4];
+    std::shared_ptr<const S21Matrix> inverse;
+    std::shared_ptr<const S21LU> lu;
+    std::shared_ptr<const S21MixedLU> mixed_lu;
+    std::shared_ptr<const S21Cholesky> cholesky;
+    std::shared_ptr<const S21Cholesky> ldlt;
+    std::shared_ptr<const S21QR> qr;
+    std::shared_ptr<const S21SVD> svd;
+  };
+  mutable DerivedCache cache_;
+  // Guards the cache, so a matrix shared between threads computes every
+  // derived result once. Recursive since derived results use each other
+  mutable std::recursive_mutex cache_mutex_;
 
   /* ============================== Methods ================================= */
-  void InitMatrix();
+  void InitMatrix(bool zero = true);
   void CopyMatrix(const S21Matrix& other);
+  void CopyCells(const double* const* source);
+  bool ShareMatrix(const S21Matrix& other);
+  void Detach();
   void ClearMatrix() noexcept;
   void FillMatrix(S21Matrix& newMatrix, int rows, int cols);
   void CheckIfSizesAreEqual(const S21Matrix& other) const;
   void CheckIfSquare() const;
+  void CheckIfNotEmpty() const;
   void ComplementsHelp(S21Matrix& complements) const;
   void FindMinor(S21Matrix& minor, int row, int col) const noexcept;
   double DetHelp() const;
+  double ComputeNorm(NormType type) const;
   void CheckIfIndexExists(int row, int col) const;
+  void Touch() noexcept;
+  DerivedCache& ValidCache() const noexcept;
+  void AdoptCache(const S21Matrix& other);
+  const S21LU& CachedLU() const;
+  void AddTransposed(const S21TransposedView& other, double sign);
+  void Accumulate(double alpha, const S21Matrix& other);
+  void SquareInPlace(S21Matrix& scratch);
+  void ForEachChunk(Execution execution,
+                    const std::function<void(size_t, size_t)>& body) const;
+};
+
+// Returns a matrix with function applied to every element
+template <typename Function>
+S21Matrix S21Matrix::Apply(Function function, Execution execution) const {
+  S21Matrix result(*this);
+  result.ApplyInPlace(function, execution);
+  return result;
+}
+
+// Replaces every element x with function(x). The loop runs over the
+// contiguous cells without bounds checks, so an inlined function is
+// vectorized by the compiler. In parallel execution function is called from
+// several threads at once
+template <typename Function>
+void S21Matrix::ApplyInPlace(Function function, Execution execution) {
+  if (rows_ < 1) return;
+  Detach();
+  double* cells = matrix_[0];
+  ForEachChunk(execution, [cells, &function](size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) {
+      cells[i] = function(cells[i]);
+    }
+  });
+  Touch();
+}
+
+// Returns a matrix of function(x, y) for the corresponding elements x of the
+// matrix and y of other
+template <typename Function>
+S21Matrix S21Matrix::Zip(const S21Matrix& other, Function function,
+                         Execution execution) const {
+  S21Matrix result(*this);
+  result.ZipInPlace(other, function, execution);
+  return result;
+}
+
+// Replaces every element x with function(x, y), where y is the corresponding
+// element of other. The sizes must be equal, other may be the matrix itself
+template <typename Function>
+void S21Matrix::ZipInPlace(const S21Matrix& other, Function function,
+                           Execution execution) {
+  CheckIfSizesAreEqual(other);
+  if (rows_ < 1) return;
+  Detach();
+  double* cells = matrix_[0];
+  const double* operand = other.matrix_[0];
+  ForEachChunk(execution,
+               [cells, operand, &function](size_t first, size_t last) {
+                 for (size_t i = first; i < last; i++) {
+                   cells[i] = function(cells[i], operand[i]);
+                 }
+               });
+  Touch();
+}
+
+// Transposed view of a matrix. It copies nothing and stays valid while the
+// viewed matrix is alive and unchanged. Products, sums and matrix-vector
+// kernels read the viewed matrix in transposed order instead of materializing
+// the transpose
+class S21TransposedView {
+  friend class S21Matrix;
+
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21TransposedView(const S21Matrix& matrix) noexcept;
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  const S21Matrix& GetMatrix() const noexcept;
+
+  /* ============================== Functions =============================== */
+  S21Matrix Materialize() const;
+  S21Vector MulVector(const S21Vector& vector) const;
+
+  /* ============================== Operators =============================== */
+  S21Matrix operator+(const S21Matrix& other) const;
+  S21Matrix operator*(const S21Matrix& other) const;
+  S21Matrix operator*(const S21TransposedView& other) const;
+  double operator()(int row, int col) const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  const S21Matrix* matrix_;
 };
 
 #endif  // S21_MATRIX_OOP_H
@@ -0,0 +1,214 @@
+#include "s21_memory.h"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Log2 of the size of a huge page
+static constexpr int kHugePageShift = 21;
+// Size of a huge page. Blocks of at least this size are mapped directly, so
+// their pages can be given a policy before anything touches them; they are
+// aligned to it and their length is rounded up to it
+static constexpr size_t kHugePageBytes = size_t{1} << kHugePageShift;
+// Nodes that fit into the one-word node mask passed to the kernel
+static constexpr int kMaxNodes = 64;
+
+static std::atomic<S21NumaPolicy> policy{S21NumaPolicy::kDefault};
+static std::atomic<int> bound_node{0};
+static std::atomic<S21HugePagePolicy> page_policy{
+    S21HugePagePolicy::kTransparent};
+static std::atomic<long long> heap_blocks{0}, regular_blocks{0},
+    transparent_blocks{0}, hugetlb_blocks{0}, fallback_blocks{0};
+
+// Sets the placement policy for new matrices
+void S21SetNumaPolicy(S21NumaPolicy new_policy, int node) {
+  if (new_policy == S21NumaPolicy::kBind &&
+      (node < 0 || node >= S21GetNumaNodeCount())) {
+    throw std::invalid_argument("NUMA node doesn't exist");
+  }
+  bound_node = node;
+  policy = new_policy;
+}
+
+// Returns the placement policy for new matrices
+S21NumaPolicy S21GetNumaPolicy() noexcept { return policy; }
+
+// Returns the node used by kBind
+int S21GetNumaNode() noexcept { return bound_node; }
+
+// Reads the list of online nodes ("0", "0-1", "0,2-3") once, the count is the
+// largest node number plus one
+int S21GetNumaNodeCount() noexcept {
+  static const int count = [] {
+    std::ifstream file("/sys/devices/system/node/online");
+    std::string list;
+    if (!(file >> list)) return 1;
+    int largest = 0, number = 0;
+    for (char symbol : list) {
+      if (symbol >= '0' && symbol <= '9') {
+        number = number * 10 + (symbol - '0');
+      } else {
+        largest = std::max(largest, number);
+        number = 0;
+      }
+    }
+    return std::min(kMaxNodes, std::max(largest, number) + 1);
+  }();
+  return count;
+}
+
+// Applies the interleave or bind policy to a mapped block. Placement is a hint:
+// when the kernel refuses it the pages are placed by first touch
+static void PlacePages(void *data, size_t bytes) noexcept {
+#ifdef __linux__
+  const S21NumaPolicy current = policy;
+  const int nodes = S21GetNumaNodeCount();
+  unsigned long mask = 0;
+  int mode = 0;
+  if (current == S21NumaPolicy::kInterleave && nodes > 1) {
+    mode = MPOL_INTERLEAVE;
+    mask = nodes == kMaxNodes ? ~0UL : (1UL << nodes) - 1;
+  } else if (current == S21NumaPolicy::kBind) {
+    mode = MPOL_BIND;
+    mask = 1UL << bound_node;
+  } else {
+    return;
+  }
+  syscall(SYS_mbind, data, bytes, mode, &mask, kMaxNodes + 1, 0);
+#else
+  (void)data;
+  (void)bytes;
+#endif
+}
+
+// Sets the page size policy for new blocks
+void S21SetHugePagePolicy(S21HugePagePolicy new_policy) noexcept {
+  page_policy = new_policy;
+}
+
+// Returns the page size policy for new blocks
+S21HugePagePolicy S21GetHugePagePolicy() noexcept { return page_policy; }
+
+// Returns a snapshot of the backing counters
+S21PageCounters S21GetPageCounters() noexcept {
+  return {heap_blocks, regular_blocks, transparent_blocks, hugetlb_blocks,
+          fallback_blocks};
+}
+
+// Sets the backing counters to zero
+void S21ResetPageCounters() noexcept {
+  heap_blocks = 0;
+  regular_blocks = 0;
+  transparent_blocks = 0;
+  hugetlb_blocks = 0;
+  fallback_blocks = 0;
+}
+
+// Returns the length of the mapping that holds a block of the given size
+static size_t MappedLength(size_t bytes) noexcept {
+  return (bytes + kHugePageBytes - 1) / kHugePageBytes * kHugePageBytes;
+}
+
+// Maps length bytes from the 2 MB explicit huge page pool, returns nullptr
+// when the pool can't provide them. The page size is requested explicitly:
+// the default pool of the host may use 1 GB pages, and then the length would
+// not be a multiple of the page size and munmap of it would fail
+static void *MapHugetlb(size_t length) noexcept {
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+  void *data = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                        (kHugePageShift << MAP_HUGE_SHIFT),
+                    -1, 0);
+  if (data != MAP_FAILED) return data;
+#else
+  (void)length;
+#endif
+  return nullptr;
+}
+
+// Maps length bytes on base pages at a 2 MB boundary: one huge page more is
+// reserved and the unaligned head and the tail are given back
+static void *MapAligned(size_t length) {
+  const size_t reserved = length + kHugePageBytes;
+  void *raw = mmap(nullptr, reserved, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  char *begin = static_cast<char *>(raw);
+  const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(begin);
+  char *aligned = begin + (kHugePageBytes - address % kHugePageBytes) %
+                              kHugePageBytes;
+  if (aligned != begin) {
+    munmap(begin, aligned - begin);
+  }
+  munmap(aligned + length, begin + reserved - (aligned + length));
+  return aligned;
+}
+
+// Advises a mapped block for transparent huge pages, returns false when the
+// kernel doesn't support them
+static bool AdviseHugePages(void *data, size_t length) noexcept {
+#ifdef MADV_HUGEPAGE
+  return madvise(data, length, MADV_HUGEPAGE) == 0;
+#else
+  (void)data;
+  (void)length;
+  return false;
+#endif
+}
+
+// Allocates count doubles without initializing them
+double *S21Allocate(size_t count) {
+  const size_t bytes = count * sizeof(double);
+  if (bytes < kHugePageBytes) {
+    double *data = new double[count];
+    heap_blocks++;
+    return data;
+  }
+  const size_t length = MappedLength(bytes);
+  const S21HugePagePolicy pages = page_policy;
+  void *data = nullptr;
+  if (pages == S21HugePagePolicy::kExplicit) {
+    data = MapHugetlb(length);
+    if (data) {
+      hugetlb_blocks++;
+    } else {
+      fallback_blocks++;
+    }
+  }
+  if (!data) {
+    data = MapAligned(length);
+    if (pages != S21HugePagePolicy::kOff && AdviseHugePages(data, length)) {
+      transparent_blocks++;
+    } else {
+      regular_blocks++;
+    }
+  }
+  PlacePages(data, length);
+  return static_cast<double *>(data);
+}
+
+// Releases a block of count doubles the way it was allocated, every mapping
+// of a large block spans whole huge pages
+void S21Deallocate(double *data, size_t count) noexcept {
+  if (!data) return;
+  const size_t bytes = count * sizeof(double);
+  if (bytes < kHugePageBytes) {
+    delete[] data;
+  } else {
+    munmap(data, MappedLength(bytes));
+  }
+}
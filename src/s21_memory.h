@@ -0,0 +1,74 @@
+#ifndef S21_MEMORY_H
+#define S21_MEMORY_H
+
+#include <cstddef>
+
+// Placement of the pages of large matrices on the NUMA nodes of the host
+enum class S21NumaPolicy {
+  // Cells are zeroed and copied by the calling thread, so every page lands on
+  // the node it runs on
+  kDefault,
+  // Cells are zeroed and copied in the row partitions of the compute kernels,
+  // every page lands on the node of the thread that first writes it
+  kFirstTouch,
+  // Pages are spread round-robin over all nodes
+  kInterleave,
+  // Pages are placed on one node
+  kBind
+};
+
+// Page size requested for large blocks
+enum class S21HugePagePolicy {
+  // Base pages, the blocks get no advice
+  kOff,
+  // Blocks are aligned to 2 MB and advised for transparent huge pages
+  kTransparent,
+  // Blocks come from the 2 MB explicit huge page pool (hugetlbfs), kTransparent
+  // is used when the pool has no free pages
+  kExplicit
+};
+
+// Number of blocks that got each kind of backing since the last reset
+struct S21PageCounters {
+  long long heap;         // small blocks taken from the heap
+  long long regular;      // mapped blocks on base pages
+  long long transparent;  // mapped blocks advised for transparent huge pages
+  long long hugetlb;      // blocks on explicit huge pages
+  long long fallbacks;    // kExplicit requests the huge page pool refused
+};
+
+// Sets the policy for the matrices allocated from now on, node is only used
+// by kBind
+void S21SetNumaPolicy(S21NumaPolicy policy, int node = 0);
+
+// Returns the current placement policy
+S21NumaPolicy S21GetNumaPolicy() noexcept;
+
+// Returns the node used by kBind
+int S21GetNumaNode() noexcept;
+
+// Returns the number of NUMA nodes of the host, 1 when it can't be found out
+int S21GetNumaNodeCount() noexcept;
+
+// Sets the page size policy for the blocks allocated from now on
+void S21SetHugePagePolicy(S21HugePagePolicy policy) noexcept;
+
+// Returns the current page size policy
+S21HugePagePolicy S21GetHugePagePolicy() noexcept;
+
+// Returns the backing counters
+S21PageCounters S21GetPageCounters() noexcept;
+
+// Sets the backing counters to zero
+void S21ResetPageCounters() noexcept;
+
+// Returns an uninitialized block of count doubles. Blocks of 2 MB and more
+// are mapped directly, 2 MB-aligned, with the page size and NUMA policies
+// applied before the first touch; smaller ones come from the heap. The block
+// must be released by S21Deallocate with the same count
+double* S21Allocate(size_t count);
+
+// Releases a block returned by S21Allocate
+void S21Deallocate(double* data, size_t count) noexcept;
+
+#endif  // S21_MEMORY_H
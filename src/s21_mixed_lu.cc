@@ -0,0 +1,286 @@
+#include "s21_mixed_lu.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "s21_gemm.h"
+#include "s21_thread_pool.h"
+
+// Number of columns factorized at once before the trailing matrix is updated
+static constexpr int kPanelWidth = 64;
+// Minimal number of rows given to one thread
+static constexpr int kRowGrain = 32;
+// Maximal number of refinement steps before falling back to double precision
+static constexpr int kMaxIterations = 30;
+// Refinement in single precision needs condition * FLT_EPSILON well below one
+static constexpr double kMaxCondition = 0.1 / FLT_EPSILON;
+
+// Returns the offset of row i in a row-major array with the given number of
+// columns, in size_t so offsets of large systems don't overflow int
+static size_t RowOffset(int i, int cols) noexcept {
+  return static_cast<size_t>(i) * cols;
+}
+
+// Factorizes the matrix in single precision and estimates its condition
+S21MixedLU::S21MixedLU(const S21Matrix &matrix)
+    : matrix_(matrix),
+      size_(matrix.rows_),
+      single_usable_(false),
+      condition_(0) {
+  if (matrix.rows_ != matrix.cols_) {
+    throw std::logic_error("The matrix is not square");
+  }
+  if (matrix.rows_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+  if (FactorizeSingle()) {
+    condition_ = EstimateCondition();
+    single_usable_ = condition_ <= kMaxCondition;
+  }
+}
+
+// Returns the order of the matrix
+int S21MixedLU::GetSize() const noexcept { return size_; }
+
+// Returns the estimate of the 1-norm condition number, zero if the single
+// precision factorization failed
+double S21MixedLU::GetConditionEstimate() const noexcept { return condition_; }
+
+// Blocked right-looking LU with partial pivoting in single precision, the
+// same scheme as S21LU. Returns false if the matrix doesn't fit into floats
+// or a zero pivot is met
+bool S21MixedLU::FactorizeSingle() {
+  const int n = size_;
+  lu_.resize(static_cast<size_t>(n) * n);
+  pivots_.resize(n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      const double value = matrix_.matrix_[i][j];
+      if (fabs(value) > FLT_MAX) return false;
+      lu_[RowOffset(i, n) + j] = static_cast<float>(value);
+    }
+  }
+  float *a = lu_.data();
+  for (int from = 0; from < n; from += kPanelWidth) {
+    const int to = std::min(n, from + kPanelWidth);
+    for (int j = from; j < to; j++) {
+      int pivot = j;
+      for (int i = j + 1; i < n; i++) {
+        if (fabsf(a[RowOffset(i, n) + j]) > fabsf(a[RowOffset(pivot, n) + j])) {
+          pivot = i;
+        }
+      }
+      pivots_[j] = pivot;
+      if (pivot != j) {
+        std::swap_ranges(a + RowOffset(j, n), a + RowOffset(j, n) + n,
+                         a + RowOffset(pivot, n));
+      }
+      const float *pivot_row = a + RowOffset(j, n);
+      if (pivot_row[j] == 0.0f) return false;
+      const float inverse = 1.0f / pivot_row[j];
+      for (int i = j + 1; i < n; i++) {
+        float *row = a + RowOffset(i, n);
+        row[j] *= inverse;
+        for (int c = j + 1; c < to; c++) {
+          row[c] -= row[j] * pivot_row[c];
+        }
+      }
+    }
+    if (to == n) break;
+    for (int r = from + 1; r < to; r++) {
+      float *row = a + RowOffset(r, n);
+      for (int t = from; t < r; t++) {
+        const float factor = row[t];
+        const float *source = a + RowOffset(t, n);
+        for (int c = to; c < n; c++) {
+          row[c] -= factor * source[c];
+        }
+      }
+    }
+    S21ThreadPool::Instance().ParallelFor(
+        to, n, kRowGrain, [a, from, to, n](int begin, int end) {
+          for (int i = begin; i < end; i++) {
+            float *row = a + RowOffset(i, n);
+            for (int t = from; t < to; t++) {
+              const float factor = row[t];
+              const float *source = a + RowOffset(t, n);
+              for (int c = to; c < n; c++) {
+                row[c] -= factor * source[c];
+              }
+            }
+          }
+        });
+  }
+  return true;
+}
+
+// Solves A * X = rhs in single precision, rhs is a row-major n x cols array
+void S21MixedLU::SolveSingle(std::vector<float> &rhs, int cols) const {
+  const int n = size_;
+  const float *a = lu_.data();
+  float *b = rhs.data();
+  for (int i = 0; i < n; i++) {
+    if (pivots_[i] != i) {
+      std::swap_ranges(b + RowOffset(i, cols), b + RowOffset(i, cols) + cols,
+                       b + RowOffset(pivots_[i], cols));
+    }
+  }
+  for (int i = 1; i < n; i++) {
+    float *target = b + RowOffset(i, cols);
+    for (int t = 0; t < i; t++) {
+      const float factor = a[RowOffset(i, n) + t];
+      const float *source = b + RowOffset(t, cols);
+      for (int c = 0; c < cols; c++) {
+        target[c] -= factor * source[c];
+      }
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    const float *row = a + RowOffset(i, n);
+    float *target = b + RowOffset(i, cols);
+    for (int t = i + 1; t < n; t++) {
+      const float factor = row[t];
+      const float *source = b + RowOffset(t, cols);
+      for (int c = 0; c < cols; c++) {
+        target[c] -= factor * source[c];
+      }
+    }
+    const float inverse = 1.0f / row[i];
+    for (int c = 0; c < cols; c++) {
+      target[c] *= inverse;
+    }
+  }
+}
+
+// Solves A^T * x = rhs in single precision for one right-hand side:
+// U^T * z = rhs, L^T * w = z, then the row swaps are undone in reverse order
+void S21MixedLU::SolveSingleTransposed(std::vector<float> &rhs) const {
+  const int n = size_;
+  const float *a = lu_.data();
+  float *b = rhs.data();
+  for (int i = 0; i < n; i++) {
+    const float *row = a + RowOffset(i, n);
+    b[i] /= row[i];
+    for (int c = i + 1; c < n; c++) {
+      b[c] -= row[c] * b[i];
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    const float *row = a + RowOffset(i, n);
+    for (int c = 0; c < i; c++) {
+      b[c] -= row[c] * b[i];
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    std::swap(b[i], b[pivots_[i]]);
+  }
+}
+
+// Estimates ||A||_1 * ||A^-1||_1 with Hager's method, which needs only a few
+// solves with the single precision factors
+double S21MixedLU::EstimateCondition() const {
+  const int n = size_;
+  const double norm = matrix_.Norm(S21Matrix::NormType::kOne);
+  std::vector<float> x(n, 1.0f / n), y(n), z(n);
+  double estimate = 0;
+  for (int step = 0; step < 5; step++) {
+    y = x;
+    SolveSingle(y, 1);
+    estimate = 0;
+    for (int i = 0; i < n; i++) {
+      estimate += fabs(y[i]);
+      z[i] = y[i] >= 0 ? 1.0f : -1.0f;
+    }
+    SolveSingleTransposed(z);
+    int largest = 0;
+    double dot = 0;
+    for (int i = 0; i < n; i++) {
+      if (fabsf(z[i]) > fabsf(z[largest])) largest = i;
+      dot += static_cast<double>(z[i]) * x[i];
+    }
+    if (fabsf(z[largest]) <= dot) break;
+    std::fill(x.begin(), x.end(), 0.0f);
+    x[largest] = 1.0f;
+  }
+  return norm * estimate;
+}
+
+// Solves with the double precision factorization, the first call factorizes
+S21Matrix S21MixedLU::SolveDouble(const S21Matrix &rhs,
+                                  SolveReport *report) const {
+  std::call_once(fallback_once_, [this] {
+    fallback_ = std::make_unique<const S21LU>(matrix_);
+  });
+  if (report) report->used_double = true;
+  return fallback_->Solve(rhs);
+}
+
+// Solves A * X = rhs for every column of rhs. The single precision solution is
+// corrected with d = A^-1 * (rhs - A * X), the residual being computed in
+// double precision, until the residual of every column is at the level of
+// double precision rounding. The steps taken are stored in report if given
+S21Matrix S21MixedLU::Solve(const S21Matrix &rhs, SolveReport *report) const {
+  if (rhs.rows_ != size_) {
+    throw std::invalid_argument(
+        "Right-hand side rows are not equal to the matrix size");
+  }
+  if (report) *report = SolveReport{};
+  if (!single_usable_) {
+    return SolveDouble(rhs, report);
+  }
+  const int n = size_, k = rhs.cols_;
+  const double matrix_norm = matrix_.Norm(S21Matrix::NormType::kInf);
+  const double tolerance = matrix_norm * DBL_EPSILON * sqrt(n);
+
+  std::vector<float> correction(static_cast<size_t>(n) * k);
+  S21Matrix solution(n, k), residual(n, k);
+  for (int i = 0; i < n; i++) {
+    for (int c = 0; c < k; c++) {
+      correction[static_cast<size_t>(i) * k + c] =
+          static_cast<float>(rhs.matrix_[i][c]);
+    }
+  }
+  SolveSingle(correction, k);
+  for (int i = 0; i < n; i++) {
+    for (int c = 0; c < k; c++) {
+      solution.matrix_[i][c] = correction[static_cast<size_t>(i) * k + c];
+    }
+  }
+  for (int step = 0; step <= kMaxIterations; step++) {
+    if (report) report->iterations = step;
+    // residual = rhs - A * solution
+    for (int i = 0; i < n; i++) {
+      for (int c = 0; c < k; c++) {
+        residual.matrix_[i][c] = -rhs.matrix_[i][c];
+      }
+    }
+    S21Gemm(n, k, n, matrix_.matrix_, solution.matrix_, residual.matrix_);
+    bool converged = true;
+    for (int c = 0; c < k && converged; c++) {
+      double residual_norm = 0, solution_norm = 0;
+      for (int i = 0; i < n; i++) {
+        residual_norm = std::max(residual_norm, fabs(residual.matrix_[i][c]));
+        solution_norm = std::max(solution_norm, fabs(solution.matrix_[i][c]));
+      }
+      converged = residual_norm <= solution_norm * tolerance;
+    }
+    if (converged) {
+      solution.Touch();
+      return solution;
+    }
+    if (step == kMaxIterations) break;
+    for (int i = 0; i < n; i++) {
+      for (int c = 0; c < k; c++) {
+        correction[static_cast<size_t>(i) * k + c] =
+            static_cast<float>(-residual.matrix_[i][c]);
+      }
+    }
+    SolveSingle(correction, k);
+    for (int i = 0; i < n; i++) {
+      for (int c = 0; c < k; c++) {
+        solution.matrix_[i][c] += correction[static_cast<size_t>(i) * k + c];
+      }
+    }
+  }
+  return SolveDouble(rhs, report);
+}
@@ -0,0 +1,56 @@
+#ifndef S21_MIXED_LU_H
+#define S21_MIXED_LU_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "s21_lu.h"
+#include "s21_matrix_oop.h"
+
+// Mixed precision LU solver: the matrix is factorized in single precision and
+// solutions are refined with double precision residuals until they reach
+// double precision accuracy. When the condition estimate shows that the
+// refinement can't converge, or it doesn't converge in practice, the solver
+// falls back to the double precision S21LU. Solve is const and may run on
+// several threads at once
+class S21MixedLU {
+ public:
+  // Outcome of one solve: refinement steps taken and whether the double
+  // precision factorization had to be used
+  struct SolveReport {
+    int iterations = 0;
+    bool used_double = false;
+  };
+
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21MixedLU(const S21Matrix& matrix);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  double GetConditionEstimate() const noexcept;
+
+  /* ============================== Functions =============================== */
+  S21Matrix Solve(const S21Matrix& rhs, SolveReport* report = nullptr) const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  S21Matrix matrix_;
+  int size_;
+  std::vector<float> lu_;
+  std::vector<int> pivots_;
+  bool single_usable_;
+  double condition_;
+  // Double precision factorization, made once by the first solve needing it
+  mutable std::unique_ptr<const S21LU> fallback_;
+  mutable std::once_flag fallback_once_;
+
+  /* ============================== Methods ================================= */
+  bool FactorizeSingle();
+  void SolveSingle(std::vector<float>& rhs, int cols) const;
+  void SolveSingleTransposed(std::vector<float>& rhs) const;
+  double EstimateCondition() const;
+  S21Matrix SolveDouble(const S21Matrix& rhs, SolveReport* report) const;
+};
+
+#endif  // S21_MIXED_LU_H
@@ -0,0 +1,334 @@
+#include "s21_qr.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "s21_thread_pool.h"
+
+// Number of reflectors gathered into one compact WY block
+static constexpr int kPanelWidth = 32;
+// Minimal number of columns given to one thread when a block is applied
+static constexpr int kColumnGrain = 32;
+
+// Factorizes the given matrix
+S21QR::S21QR(const S21Matrix &matrix) : qr_(matrix) {
+  if (matrix.rows_ < 1 || matrix.cols_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+  if (matrix.rows_ < matrix.cols_) {
+    throw std::logic_error("The matrix has less rows than columns");
+  }
+  qr_.Detach();
+  Factorize();
+  qr_.Touch();
+}
+
+// Returns the number of rows of the factorized matrix
+int S21QR::GetRows() const noexcept { return qr_.rows_; }
+
+// Returns the number of columns of the factorized matrix
+int S21QR::GetCols() const noexcept { return qr_.cols_; }
+
+// Checks if no diagonal element of R is negligible compared to the largest one
+bool S21QR::IsFullRank() const noexcept {
+  double largest = 0;
+  for (int i = 0; i < qr_.cols_; i++) {
+    largest = std::max(largest, fabs(qr_.matrix_[i][i]));
+  }
+  const double tolerance = largest * qr_.rows_ * DBL_EPSILON;
+  for (int i = 0; i < qr_.cols_; i++) {
+    if (!(fabs(qr_.matrix_[i][i]) > tolerance)) return false;
+  }
+  return true;
+}
+
+// Returns the square upper triangular factor R
+S21Matrix S21QR::GetR() const {
+  S21Matrix upper(qr_.cols_, qr_.cols_);
+  for (int i = 0; i < qr_.cols_; i++) {
+    std::copy(qr_.matrix_[i] + i, qr_.matrix_[i] + qr_.cols_,
+              upper.matrix_[i] + i);
+  }
+  return upper;
+}
+
+// Returns Q with as many columns as the matrix when thin, square otherwise
+S21Matrix S21QR::GetQ(bool thin) const {
+  S21Matrix orthogonal(qr_.rows_, thin ? qr_.cols_ : qr_.rows_);
+  for (int i = 0; i < orthogonal.cols_; i++) {
+    orthogonal.matrix_[i][i] = 1.0;
+  }
+  ApplyQ(orthogonal);
+  return orthogonal;
+}
+
+// Blocked factorization: a panel of reflectors is computed column by column,
+// its T factor is formed and the whole block is applied to the trailing
+// columns at once
+void S21QR::Factorize() {
+  const int n = qr_.cols_;
+  tau_.assign(n, 0.0);
+  for (int from = 0; from < n; from += kPanelWidth) {
+    const int to = std::min(n, from + kPanelWidth);
+    FactorizePanel(from, to);
+    FormT(from, to);
+    ApplyBlock(from, to, qr_.matrix_, to, n, true);
+  }
+}
+
+// Computes the reflectors of columns [from, to) and applies each of them to
+// the rest of the panel
+void S21QR::FactorizePanel(int from, int to) {
+  const int m = qr_.rows_;
+  double **a = qr_.matrix_;
+  std::vector<double> w(to);
+  for (int j = from; j < to; j++) {
+    double tail = 0;
+    for (int i = j + 1; i < m; i++) {
+      tail += a[i][j] * a[i][j];
+    }
+    const double alpha = a[j][j];
+    if (tail == 0) {
+      tau_[j] = 0;
+      continue;
+    }
+    const double beta = alpha >= 0 ? -sqrt(alpha * alpha + tail)
+                                   : sqrt(alpha * alpha + tail);
+    tau_[j] = (beta - alpha) / beta;
+    const double scale = 1.0 / (alpha - beta);
+    for (int i = j + 1; i < m; i++) {
+      a[i][j] *= scale;
+    }
+    a[j][j] = beta;
+    // w = v^T * A(:, j + 1 : to), then A -= tau * v * w
+    for (int c = j + 1; c < to; c++) {
+      w[c] = a[j][c];
+    }
+    for (int i = j + 1; i < m; i++) {
+      const double v = a[i][j];
+      for (int c = j + 1; c < to; c++) {
+        w[c] += v * a[i][c];
+      }
+    }
+    for (int c = j + 1; c < to; c++) {
+      a[j][c] -= tau_[j] * w[c];
+    }
+    for (int i = j + 1; i < m; i++) {
+      const double v = tau_[j] * a[i][j];
+      for (int c = j + 1; c < to; c++) {
+        a[i][c] -= v * w[c];
+      }
+    }
+  }
+}
+
+// Forms the upper triangular T of the panel [from, to) column by column:
+// T(0:j, j) = -tau_j * T(0:j, 0:j) * V(:, 0:j)^T * v_j
+void S21QR::FormT(int from, int to) {
+  const int m = qr_.rows_;
+  const int width = to - from;
+  double **a = qr_.matrix_;
+  std::vector<double> t(width * width, 0.0);
+  std::vector<double> z(width);
+  for (int j = 0; j < width; j++) {
+    const int column = from + j;
+    std::fill(z.begin(), z.end(), 0.0);
+    for (int k = 0; k < j; k++) {
+      z[k] = a[column][from + k];
+    }
+    for (int i = column + 1; i < m; i++) {
+      const double v = a[i][column];
+      for (int k = 0; k < j; k++) {
+        z[k] += a[i][from + k] * v;
+      }
+    }
+    for (int k = 0; k < j; k++) {
+      double sum = 0;
+      for (int l = k; l < j; l++) {
+        sum += t[k * width + l] * z[l];
+      }
+      t[k * width + j] = -tau_[column] * sum;
+    }
+    t[j * width + j] = tau_[column];
+  }
+  t_blocks_.push_back(std::move(t));
+}
+
+// Applies the block reflector of the panel [from, to), or its transpose, to
+// columns [col_begin, col_end) of target: C -= V * op(T) * (V^T * C). Slabs of
+// columns are independent, so they are processed in parallel
+void S21QR::ApplyBlock(int from, int to, double **target, int col_begin,
+                       int col_end, bool transpose) const {
+  const int m = qr_.rows_;
+  const int width = to - from;
+  double **a = qr_.matrix_;
+  const std::vector<double> &t = t_blocks_[from / kPanelWidth];
+  S21ThreadPool::Instance().ParallelFor(
+      col_begin, col_end, kColumnGrain,
+      [=, &t](int begin, int end) {
+        const int span = end - begin;
+        std::vector<double> w(width * span, 0.0);
+        // W = V^T * C, V has a unit diagonal and zeros above it
+        for (int i = from; i < m; i++) {
+          const double *row = target[i] + begin;
+          const int last = std::min(width, i - from + 1);
+          for (int k = 0; k < last; k++) {
+            const double v = (i == from + k) ? 1.0 : a[i][from + k];
+            double *w_row = w.data() + k * span;
+            for (int c = 0; c < span; c++) {
+              w_row[c] += v * row[c];
+            }
+          }
+        }
+        // W = op(T) * W in place
+        if (transpose) {
+          for (int k = width - 1; k >= 0; k--) {
+            double *w_row = w.data() + k * span;
+            for (int c = 0; c < span; c++) {
+              w_row[c] *= t[k * width + k];
+            }
+            for (int l = 0; l < k; l++) {
+              const double factor = t[l * width + k];
+              const double *source = w.data() + l * span;
+              for (int c = 0; c < span; c++) {
+                w_row[c] += factor * source[c];
+              }
+            }
+          }
+        } else {
+          for (int k = 0; k < width; k++) {
+            double *w_row = w.data() + k * span;
+            for (int c = 0; c < span; c++) {
+              w_row[c] *= t[k * width + k];
+            }
+            for (int l = k + 1; l < width; l++) {
+              const double factor = t[k * width + l];
+              const double *source = w.data() + l * span;
+              for (int c = 0; c < span; c++) {
+                w_row[c] += factor * source[c];
+              }
+            }
+          }
+        }
+        // C -= V * W
+        for (int i = from; i < m; i++) {
+          double *row = target[i] + begin;
+          const int last = std::min(width, i - from + 1);
+          for (int k = 0; k < last; k++) {
+            const double v = (i == from + k) ? 1.0 : a[i][from + k];
+            const double *w_row = w.data() + k * span;
+            for (int c = 0; c < span; c++) {
+              row[c] -= v * w_row[c];
+            }
+          }
+        }
+      });
+}
+
+// Checks if the right-hand side has as many rows as the matrix
+void S21QR::CheckRhs(const S21Matrix &rhs) const {
+  if (rhs.rows_ != qr_.rows_) {
+    throw std::invalid_argument(
+        "Right-hand side rows are not equal to the matrix rows");
+  }
+}
+
+// Overwrites the given matrix with Q * matrix without forming Q
+void S21QR::ApplyQ(S21Matrix &matrix) const {
+  CheckRhs(matrix);
+  matrix.Detach();
+  const int n = qr_.cols_;
+  const int last = (n - 1) / kPanelWidth * kPanelWidth;
+  for (int from = last; from >= 0; from -= kPanelWidth) {
+    ApplyBlock(from, std::min(n, from + kPanelWidth), matrix.matrix_, 0,
+               matrix.cols_, false);
+  }
+  matrix.Touch();
+}
+
+// Overwrites the given matrix with Q^T * matrix without forming Q
+void S21QR::ApplyQTransposed(S21Matrix &matrix) const {
+  CheckRhs(matrix);
+  matrix.Detach();
+  const int n = qr_.cols_;
+  for (int from = 0; from < n; from += kPanelWidth) {
+    ApplyBlock(from, std::min(n, from + kPanelWidth), matrix.matrix_, 0,
+               matrix.cols_, true);
+  }
+  matrix.Touch();
+}
+
+// Returns X minimizing the 2-norm of A * X - rhs for every column of rhs,
+// computed as R^-1 * (Q^T * rhs) restricted to the first columns of Q
+S21Matrix S21QR::Solve(const S21Matrix &rhs) const {
+  CheckRhs(rhs);
+  if (!IsFullRank()) {
+    throw std::logic_error("The matrix is rank deficient");
+  }
+  S21Matrix projected(rhs);
+  ApplyQTransposed(projected);
+  const int n = qr_.cols_;
+  S21Matrix solution(n, rhs.cols_);
+  for (int i = n - 1; i >= 0; i--) {
+    double *target = solution.matrix_[i];
+    std::copy(projected.matrix_[i], projected.matrix_[i] + rhs.cols_, target);
+    for (int t = i + 1; t < n; t++) {
+      const double factor = qr_.matrix_[i][t];
+      const double *source = solution.matrix_[t];
+      for (int c = 0; c < rhs.cols_; c++) {
+        target[c] -= factor * source[c];
+      }
+    }
+    const double inverse = 1.0 / qr_.matrix_[i][i];
+    for (int c = 0; c < rhs.cols_; c++) {
+      target[c] *= inverse;
+    }
+  }
+  return solution;
+}
+
+// Least squares for tall-skinny matrices (TSQR): blocks of rows are factorized
+// in parallel, each block reduces its rows of the problem to an n x n
+// triangle, and the stacked triangles are solved with one small QR
+S21Matrix S21QR::SolveTallSkinny(const S21Matrix &matrix,
+                                 const S21Matrix &rhs) {
+  if (rhs.rows_ != matrix.rows_) {
+    throw std::invalid_argument(
+        "Right-hand side rows are not equal to the matrix rows");
+  }
+  const int m = matrix.rows_, n = matrix.cols_, k = rhs.cols_;
+  const int blocks = std::min(S21ThreadPool::Instance().GetThreadCount(),
+                              m / std::max(1, 2 * n));
+  if (blocks < 2) {
+    return S21QR(matrix).Solve(rhs);
+  }
+  S21Matrix reduced(blocks * n, n);
+  S21Matrix reduced_rhs(blocks * n, k);
+  const int step = m / blocks;
+  S21ThreadPool::Instance().ParallelFor(0, blocks, 1, [&](int first,
+                                                          int last) {
+    for (int b = first; b < last; b++) {
+      const int begin = b * step;
+      const int end = (b == blocks - 1) ? m : begin + step;
+      S21Matrix part(end - begin, n);
+      S21Matrix part_rhs(end - begin, k);
+      for (int i = begin; i < end; i++) {
+        std::copy(matrix.matrix_[i], matrix.matrix_[i] + n,
+                  part.matrix_[i - begin]);
+        std::copy(rhs.matrix_[i], rhs.matrix_[i] + k,
+                  part_rhs.matrix_[i - begin]);
+      }
+      S21QR local(part);
+      local.ApplyQTransposed(part_rhs);
+      for (int i = 0; i < n; i++) {
+        std::fill(reduced.matrix_[b * n + i],
+                  reduced.matrix_[b * n + i] + i, 0.0);
+        std::copy(local.qr_.matrix_[i] + i, local.qr_.matrix_[i] + n,
+                  reduced.matrix_[b * n + i] + i);
+        std::copy(part_rhs.matrix_[i], part_rhs.matrix_[i] + k,
+                  reduced_rhs.matrix_[b * n + i]);
+      }
+    }
+  });
+  return S21QR(reduced).Solve(reduced_rhs);
+}
@@ -0,0 +1,48 @@
+#ifndef S21_QR_H
+#define S21_QR_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Householder QR factorization A = Q * R of a matrix with at least as many
+// rows as columns. The reflectors are stored below the diagonal of R with an
+// implicit unit head, and every panel of reflectors keeps the triangular T of
+// its compact WY form H1 * ... * Hk = I - V * T * V^T, so Q is never formed
+// unless asked for
+class S21QR {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21QR(const S21Matrix& matrix);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetRows() const noexcept;
+  int GetCols() const noexcept;
+  bool IsFullRank() const noexcept;
+  S21Matrix GetR() const;
+  S21Matrix GetQ(bool thin = true) const;
+
+  /* ============================== Functions =============================== */
+  void ApplyQ(S21Matrix& matrix) const;
+  void ApplyQTransposed(S21Matrix& matrix) const;
+  S21Matrix Solve(const S21Matrix& rhs) const;
+  static S21Matrix SolveTallSkinny(const S21Matrix& matrix,
+                                   const S21Matrix& rhs);
+
+ private:
+  /* ============================= Attributes =============================== */
+  S21Matrix qr_;
+  std::vector<double> tau_;
+  // T factor of every panel, stored row by row
+  std::vector<std::vector<double>> t_blocks_;
+
+  /* ============================== Methods ================================= */
+  void Factorize();
+  void FactorizePanel(int from, int to);
+  void FormT(int from, int to);
+  void ApplyBlock(int from, int to, double** target, int col_begin,
+                  int col_end, bool transpose) const;
+  void CheckRhs(const S21Matrix& rhs) const;
+};
+
+#endif  // S21_QR_H
@@ -0,0 +1,126 @@
+#include "s21_reduce.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Elements summed directly by the four accumulators of a pairwise sum, the
+// block fits into L1 together with the second operand of a dot product
+static constexpr size_t kPairwiseBlock = 128;
+
+// Sums term(i) over [begin, end). Short ranges use four independent
+// accumulators, longer ones are halved at a multiple of the block and the
+// halves are summed recursively
+template <typename Term>
+static double Pairwise(size_t begin, size_t end, const Term &term) noexcept {
+  const size_t size = end - begin;
+  if (size > kPairwiseBlock) {
+    const size_t middle =
+        begin + (size / 2 + kPairwiseBlock - 1) / kPairwiseBlock *
+                    kPairwiseBlock;
+    return Pairwise(begin, middle, term) + Pairwise(middle, end, term);
+  }
+  double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    sum0 += term(i);
+    sum1 += term(i + 1);
+    sum2 += term(i + 2);
+    sum3 += term(i + 3);
+  }
+  for (; i < end; i++) {
+    sum0 += term(i);
+  }
+  return (sum0 + sum1) + (sum2 + sum3);
+}
+
+// Returns the sum of the elements
+double S21Sum(const double *x, size_t size) noexcept {
+  return Pairwise(0, size, [x](size_t i) { return x[i]; });
+}
+
+// Returns the sum of the absolute values of the elements
+double S21AbsSum(const double *x, size_t size) noexcept {
+  return Pairwise(0, size, [x](size_t i) { return fabs(x[i]); });
+}
+
+// Returns the sum of the squares of the elements divided by scale. Scaling by
+// the largest element keeps the squares from overflowing or underflowing
+double S21SquareSum(const double *x, size_t size, double scale) noexcept {
+  if (scale == 1.0) {
+    return Pairwise(0, size, [x](size_t i) { return x[i] * x[i]; });
+  }
+  return Pairwise(0, size, [x, scale](size_t i) {
+    const double scaled = x[i] / scale;
+    return scaled * scaled;
+  });
+}
+
+// Returns the dot product of two arrays of the given size
+double S21PairwiseDot(const double *x, const double *y, size_t size) noexcept {
+  return Pairwise(0, size, [x, y](size_t i) { return x[i] * y[i]; });
+}
+
+// Returns the larger of the running maximum and the value, a NaN value wins
+// and a NaN maximum is kept (std::max would drop a NaN value)
+static double MaxOrNaN(double maximum, double value) noexcept {
+  return (value > maximum || value != value) ? value : maximum;
+}
+
+// Returns the largest absolute value, NaN if any element is NaN. Four running
+// maxima are kept so the loop has no dependency between neighbouring elements
+double S21MaxAbs(const double *x, size_t size) noexcept {
+  double max0 = 0, max1 = 0, max2 = 0, max3 = 0;
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    max0 = MaxOrNaN(max0, fabs(x[i]));
+    max1 = MaxOrNaN(max1, fabs(x[i + 1]));
+    max2 = MaxOrNaN(max2, fabs(x[i + 2]));
+    max3 = MaxOrNaN(max3, fabs(x[i + 3]));
+  }
+  for (; i < size; i++) {
+    max0 = MaxOrNaN(max0, fabs(x[i]));
+  }
+  return MaxOrNaN(MaxOrNaN(max0, max1), MaxOrNaN(max2, max3));
+}
+
+// Finds the extreme value with four running extremes, then the first element
+// equal to it. A NaN counts as the extreme, so the first NaN is found when
+// there is one. Both loops are branch-free over the elements but the last
+template <typename Better>
+static size_t ArgExtreme(const double *x, size_t size,
+                         const Better &better) noexcept {
+  auto pick = [&better](double value, double best) {
+    return (better(value, best) || value != value) ? value : best;
+  };
+  double best0 = x[0], best1 = x[0], best2 = x[0], best3 = x[0];
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    best0 = pick(x[i], best0);
+    best1 = pick(x[i + 1], best1);
+    best2 = pick(x[i + 2], best2);
+    best3 = pick(x[i + 3], best3);
+  }
+  for (; i < size; i++) {
+    best0 = pick(x[i], best0);
+  }
+  const double best = pick(pick(best1, best0), pick(best3, best2));
+  if (best != best) {
+    for (i = 0; i < size; i++) {
+      if (x[i] != x[i]) return i;
+    }
+  }
+  for (i = 0; i < size; i++) {
+    if (x[i] == best) return i;
+  }
+  return 0;
+}
+
+// Returns the index of the first smallest element
+size_t S21ArgMin(const double *x, size_t size) noexcept {
+  return ArgExtreme(x, size, [](double a, double b) { return a < b; });
+}
+
+// Returns the index of the first largest element
+size_t S21ArgMax(const double *x, size_t size) noexcept {
+  return ArgExtreme(x, size, [](double a, double b) { return a > b; });
+}
@@ -0,0 +1,35 @@
+#ifndef S21_REDUCE_H
+#define S21_REDUCE_H
+
+#include <cstddef>
+
+// Reduction kernels over contiguous arrays shared by the matrix reductions.
+// Sums are pairwise: blocks are summed with independent accumulators the
+// compiler can keep in vector registers, then halves are added recursively,
+// so the rounding error grows with log(size) instead of size
+
+// Returns the sum of the elements
+double S21Sum(const double* x, size_t size) noexcept;
+
+// Returns the sum of the absolute values of the elements
+double S21AbsSum(const double* x, size_t size) noexcept;
+
+// Returns the sum of the squares of the elements divided by scale
+double S21SquareSum(const double* x, size_t size, double scale = 1.0) noexcept;
+
+// Returns the dot product of two arrays of the given size
+double S21PairwiseDot(const double* x, const double* y, size_t size) noexcept;
+
+// Returns the largest absolute value of the elements, 0 for an empty array
+// and NaN when an element is NaN
+double S21MaxAbs(const double* x, size_t size) noexcept;
+
+// Returns the index of the first smallest element, or of the first NaN when
+// there is one, size must be positive
+size_t S21ArgMin(const double* x, size_t size) noexcept;
+
+// Returns the index of the first largest element, or of the first NaN when
+// there is one, size must be positive
+size_t S21ArgMax(const double* x, size_t size) noexcept;
+
+#endif  // S21_REDUCE_H
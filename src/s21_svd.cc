@@ -0,0 +1,415 @@
+#include "s21_svd.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <random>
+
+#include "s21_gemm.h"
+#include "s21_qr.h"
+#include "s21_thread_pool.h"
+
+// Minimal number of rows given to one thread
+static constexpr int kRowGrain = 16;
+// Maximal number of QR sweeps spent on one singular value
+static constexpr int kMaxIterations = 75;
+
+// Applies the plane rotation [cs sn; -sn cs] to the vectors x and y
+static void Rotate(double *x, double *y, int size, double cs, double sn) {
+  for (int i = 0; i < size; i++) {
+    const double t = cs * x[i] + sn * y[i];
+    y[i] = -sn * x[i] + cs * y[i];
+    x[i] = t;
+  }
+}
+
+// Returns the dot product of x and y on [from, to)
+static double Dot(const double *x, const double *y, int from, int to) {
+  double sum = 0;
+  for (int i = from; i < to; i++) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+// Decomposes the given matrix, wide matrices are decomposed through their
+// transpose
+S21SVD::S21SVD(const S21Matrix &matrix) {
+  if (matrix.rows_ < 1 || matrix.cols_ < 1) {
+    throw std::logic_error("The matrix is empty");
+  }
+  if (matrix.rows_ >= matrix.cols_) {
+    Decompose(matrix.Transpose());
+  } else {
+    Decompose(matrix);
+    std::swap(u_, v_);
+  }
+}
+
+// Returns the singular values in descending order
+const std::vector<double> &S21SVD::GetSingularValues() const noexcept {
+  return values_;
+}
+
+// Returns the matrix of left singular vectors, one per column
+const S21Matrix &S21SVD::GetU() const noexcept { return u_; }
+
+// Returns the matrix of right singular vectors, one per column
+const S21Matrix &S21SVD::GetV() const noexcept { return v_; }
+
+// Golub-Kahan-Reinsch SVD of the tall matrix A given as its transpose. Columns
+// of A and of U and V are kept as rows of at, ut and vt, so the reflectors and
+// rotations, which combine whole columns, run over contiguous memory, and
+// independent reflector applications are split between threads
+void S21SVD::Decompose(const S21Matrix &transposed) {
+  S21Matrix at(transposed);
+  at.Detach();
+  const int m = at.cols_, n = at.rows_;
+  double **a = at.matrix_;
+  S21Matrix ut(n, m), vt(n, n);
+  double **u = ut.matrix_, **v = vt.matrix_;
+  std::vector<double> s(n), e(n), work(m);
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+
+  // Reduction to bidiagonal form
+  const int nct = std::min(m - 1, n);
+  const int nrt = std::max(0, std::min(n - 2, m));
+  for (int k = 0; k < std::max(nct, nrt); k++) {
+    if (k < nct) {
+      s[k] = 0;
+      for (int i = k; i < m; i++) {
+        s[k] = hypot(s[k], a[k][i]);
+      }
+      if (s[k] != 0.0) {
+        if (a[k][k] < 0.0) s[k] = -s[k];
+        for (int i = k; i < m; i++) {
+          a[k][i] /= s[k];
+        }
+        a[k][k] += 1.0;
+      }
+      s[k] = -s[k];
+    }
+    const bool reflect = k < nct && s[k] != 0.0;
+    pool.ParallelFor(k + 1, n, kRowGrain, [&](int begin, int end) {
+      for (int j = begin; j < end; j++) {
+        if (reflect) {
+          const double t = -Dot(a[k], a[j], k, m) / a[k][k];
+          for (int i = k; i < m; i++) {
+            a[j][i] += t * a[k][i];
+          }
+        }
+        e[j] = a[j][k];
+      }
+    });
+    if (k < nct) {
+      std::copy(a[k] + k, a[k] + m, u[k] + k);
+    }
+    if (k < nrt) {
+      e[k] = 0;
+      for (int i = k + 1; i < n; i++) {
+        e[k] = hypot(e[k], e[i]);
+      }
+      if (e[k] != 0.0) {
+        if (e[k + 1] < 0.0) e[k] = -e[k];
+        for (int i = k + 1; i < n; i++) {
+          e[i] /= e[k];
+        }
+        e[k + 1] += 1.0;
+      }
+      e[k] = -e[k];
+      if (k + 1 < m && e[k] != 0.0) {
+        std::fill(work.begin() + k + 1, work.end(), 0.0);
+        for (int j = k + 1; j < n; j++) {
+          for (int i = k + 1; i < m; i++) {
+            work[i] += e[j] * a[j][i];
+          }
+        }
+        pool.ParallelFor(k + 1, n, kRowGrain, [&](int begin, int end) {
+          for (int j = begin; j < end; j++) {
+            const double t = -e[j] / e[k + 1];
+            for (int i = k + 1; i < m; i++) {
+              a[j][i] += t * work[i];
+            }
+          }
+        });
+      }
+      std::copy(e.begin() + k + 1, e.end(), v[k] + k + 1);
+    }
+  }
+
+  int p = n;
+  if (nct < n) s[nct] = a[nct][nct];
+  if (m < p) s[p - 1] = 0.0;
+  if (nrt + 1 < p) e[nrt] = a[p - 1][nrt];
+  e[p - 1] = 0.0;
+
+  // Generation of U
+  for (int j = nct; j < n; j++) {
+    std::fill(u[j], u[j] + m, 0.0);
+    u[j][j] = 1.0;
+  }
+  for (int k = nct - 1; k >= 0; k--) {
+    if (s[k] != 0.0) {
+      pool.ParallelFor(k + 1, n, kRowGrain, [&](int begin, int end) {
+        for (int j = begin; j < end; j++) {
+          const double t = -Dot(u[k], u[j], k, m) / u[k][k];
+          for (int i = k; i < m; i++) {
+            u[j][i] += t * u[k][i];
+          }
+        }
+      });
+      for (int i = k; i < m; i++) {
+        u[k][i] = -u[k][i];
+      }
+      u[k][k] += 1.0;
+      std::fill(u[k], u[k] + k, 0.0);
+    } else {
+      std::fill(u[k], u[k] + m, 0.0);
+      u[k][k] = 1.0;
+    }
+  }
+
+  // Generation of V
+  for (int k = n - 1; k >= 0; k--) {
+    if (k < nrt && e[k] != 0.0) {
+      pool.ParallelFor(k + 1, n, kRowGrain, [&](int begin, int end) {
+        for (int j = begin; j < end; j++) {
+          const double t = -Dot(v[k], v[j], k + 1, n) / v[k][k + 1];
+          for (int i = k + 1; i < n; i++) {
+            v[j][i] += t * v[k][i];
+          }
+        }
+      });
+    }
+    std::fill(v[k], v[k] + n, 0.0);
+    v[k][k] = 1.0;
+  }
+
+  // Implicit shifted QR on the bidiagonal matrix
+  const int pp = p - 1;
+  const double tiny = pow(2.0, -966.0);
+  int iterations = 0;
+  while (p > 0) {
+    int k, kase;
+    for (k = p - 2; k >= 0; k--) {
+      if (fabs(e[k]) <= tiny + DBL_EPSILON * (fabs(s[k]) + fabs(s[k + 1]))) {
+        e[k] = 0.0;
+        break;
+      }
+    }
+    if (k == p - 2) {
+      kase = 4;
+    } else {
+      int ks;
+      for (ks = p - 1; ks > k; ks--) {
+        const double t = (ks != p ? fabs(e[ks]) : 0.0) +
+                         (ks != k + 1 ? fabs(e[ks - 1]) : 0.0);
+        if (fabs(s[ks]) <= tiny + DBL_EPSILON * t) {
+          s[ks] = 0.0;
+          break;
+        }
+      }
+      if (ks == k) {
+        kase = 3;
+      } else if (ks == p - 1) {
+        kase = 1;
+      } else {
+        kase = 2;
+        k = ks;
+      }
+    }
+    k++;
+
+    if (kase == 1) {
+      // Deflates negligible s[p - 1]
+      double f = e[p - 2];
+      e[p - 2] = 0.0;
+      for (int j = p - 2; j >= k; j--) {
+        const double t = hypot(s[j], f);
+        const double cs = s[j] / t, sn = f / t;
+        s[j] = t;
+        if (j != k) {
+          f = -sn * e[j - 1];
+          e[j - 1] = cs * e[j - 1];
+        }
+        Rotate(v[j], v[p - 1], n, cs, sn);
+      }
+    } else if (kase == 2) {
+      // Splits at negligible s[k - 1]
+      double f = e[k - 1];
+      e[k - 1] = 0.0;
+      for (int j = k; j < p; j++) {
+        const double t = hypot(s[j], f);
+        const double cs = s[j] / t, sn = f / t;
+        s[j] = t;
+        f = -sn * e[j];
+        e[j] = cs * e[j];
+        Rotate(u[j], u[k - 1], m, cs, sn);
+      }
+    } else if (kase == 3) {
+      // One QR step with the shift from the trailing 2 x 2 block
+      if (++iterations > kMaxIterations) {
+        throw std::runtime_error("Singular values did not converge");
+      }
+      const double scale =
+          std::max({fabs(s[p - 1]), fabs(s[p - 2]), fabs(e[p - 2]),
+                    fabs(s[k]), fabs(e[k])});
+      const double sp = s[p - 1] / scale, spm1 = s[p - 2] / scale;
+      const double epm1 = e[p - 2] / scale;
+      const double sk = s[k] / scale, ek = e[k] / scale;
+      const double b = ((spm1 + sp) * (spm1 - sp) + epm1 * epm1) / 2.0;
+      const double c = (sp * epm1) * (sp * epm1);
+      double shift = 0.0;
+      if (b != 0.0 || c != 0.0) {
+        shift = sqrt(b * b + c);
+        if (b < 0.0) shift = -shift;
+        shift = c / (b + shift);
+      }
+      double f = (sk + sp) * (sk - sp) + shift;
+      double g = sk * ek;
+      for (int j = k; j < p - 1; j++) {
+        double t = hypot(f, g);
+        double cs = f / t, sn = g / t;
+        if (j != k) e[j - 1] = t;
+        f = cs * s[j] + sn * e[j];
+        e[j] = cs * e[j] - sn * s[j];
+        g = sn * s[j + 1];
+        s[j + 1] = cs * s[j + 1];
+        Rotate(v[j], v[j + 1], n, cs, sn);
+        t = hypot(f, g);
+        cs = f / t;
+        sn = g / t;
+        s[j] = t;
+        f = cs * e[j] + sn * s[j + 1];
+        s[j + 1] = -sn * e[j] + cs * s[j + 1];
+        g = sn * e[j + 1];
+        e[j + 1] = cs * e[j + 1];
+        if (j < m - 1) Rotate(u[j], u[j + 1], m, cs, sn);
+      }
+      e[p - 2] = f;
+    } else {
+      // Convergence: makes the value positive and moves it into order
+      if (s[k] <= 0.0) {
+        s[k] = (s[k] < 0.0 ? -s[k] : 0.0);
+        for (int i = 0; i <= pp; i++) {
+          v[k][i] = -v[k][i];
+        }
+      }
+      while (k < pp && s[k] < s[k + 1]) {
+        std::swap(s[k], s[k + 1]);
+        std::swap_ranges(v[k], v[k] + n, v[k + 1]);
+        std::swap_ranges(u[k], u[k] + m, u[k + 1]);
+        k++;
+      }
+      iterations = 0;
+      p--;
+    }
+  }
+
+  values_ = std::move(s);
+  u_ = ut.Transpose();
+  v_ = vt.Transpose();
+}
+
+// Returns the tolerance below which singular values are treated as zero
+double S21SVD::DefaultTolerance() const noexcept {
+  return std::max(u_.rows_, v_.rows_) * values_[0] * DBL_EPSILON;
+}
+
+// Returns the number of singular values greater than the tolerance, a negative
+// tolerance selects max(rows, cols) * largest value * machine epsilon
+int S21SVD::Rank(double tolerance) const noexcept {
+  if (tolerance < 0) tolerance = DefaultTolerance();
+  int rank = 0;
+  for (double value : values_) {
+    if (value > tolerance) rank++;
+  }
+  return rank;
+}
+
+// Returns the ratio of the largest and the smallest singular values
+double S21SVD::ConditionNumber() const noexcept {
+  return values_.front() / values_.back();
+}
+
+// Returns the Moore-Penrose pseudoinverse V * diag(1 / values) * U^T, values
+// not greater than the tolerance are dropped. Unlike InverseMatrix it works
+// for singular and non-square matrices
+S21Matrix S21SVD::PseudoInverse(double tolerance) const {
+  if (tolerance < 0) tolerance = DefaultTolerance();
+  S21Matrix scaled(v_);
+  scaled.Detach();
+  for (int i = 0; i < scaled.rows_; i++) {
+    for (int j = 0; j < scaled.cols_; j++) {
+      scaled.matrix_[i][j] =
+          values_[j] > tolerance ? scaled.matrix_[i][j] / values_[j] : 0.0;
+    }
+  }
+  return scaled * u_.Transpose();
+}
+
+// Returns U * diag(values) * V^T, the best approximation of the matrix of the
+// decomposition's rank
+S21Matrix S21SVD::Reconstruct() const {
+  S21Matrix scaled(u_);
+  scaled.Detach();
+  for (int i = 0; i < scaled.rows_; i++) {
+    for (int j = 0; j < scaled.cols_; j++) {
+      scaled.matrix_[i][j] *= values_[j];
+    }
+  }
+  return scaled * v_.Transpose();
+}
+
+// Returns the first columns of the matrix
+static S21Matrix LeadingColumns(const S21Matrix &matrix, int cols) {
+  S21Matrix result(matrix.GetRows(), cols);
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < cols; j++) {
+      result(i, j) = matrix(i, j);
+    }
+  }
+  return result;
+}
+
+// Randomized truncated SVD with the given number of components. The range of
+// the matrix is sampled with rank + oversampling Gaussian vectors, refined by
+// power iterations and orthonormalized with QR, then the small projected
+// matrix is decomposed exactly. Every pass over the large matrix is a product
+// on the blocked multithreaded kernel
+S21SVD S21SVD::Truncated(const S21Matrix &matrix, int rank, int oversampling,
+                         int power_iterations) {
+  const int m = matrix.rows_, n = matrix.cols_;
+  if (rank < 1 || rank > std::min(m, n)) {
+    throw std::invalid_argument("Invalid rank of the approximation");
+  }
+  const int samples =
+      std::min(rank + std::max(0, oversampling), std::min(m, n));
+  std::mt19937_64 generator(21);
+  std::normal_distribution<double> normal;
+  S21Matrix omega(n, samples);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < samples; j++) {
+      omega.matrix_[i][j] = normal(generator);
+    }
+  }
+  // A^T * Q, read from A in place so no transposed copy of A is kept
+  auto transposed_times = [&matrix](const S21Matrix &q) {
+    S21Matrix product(matrix.cols_, q.cols_);
+    S21GemmTN(matrix.cols_, q.cols_, matrix.rows_, matrix.matrix_, q.matrix_,
+              product.matrix_);
+    return product;
+  };
+  S21Matrix basis = S21QR(matrix * omega).GetQ();
+  for (int i = 0; i < power_iterations; i++) {
+    S21Matrix back = S21QR(transposed_times(basis)).GetQ();
+    basis = S21QR(matrix * back).GetQ();
+  }
+  // B = Q^T * A is decomposed through its tall transpose A^T * Q = Ub S Vb^T,
+  // so A ~ (Q * Vb) * S * Ub^T
+  S21SVD small(transposed_times(basis));
+  S21SVD result;
+  result.values_.assign(small.values_.begin(), small.values_.begin() + rank);
+  result.u_ = LeadingColumns(basis * small.v_, rank);
+  result.v_ = LeadingColumns(small.u_, rank);
+  return result;
+}
@@ -0,0 +1,45 @@
+#ifndef S21_SVD_H
+#define S21_SVD_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Thin singular value decomposition A = U * diag(values) * V^T with
+// r = min(rows, cols) components, singular values in descending order. The
+// full decomposition uses Golub-Kahan bidiagonalization followed by implicit
+// shifted QR on the bidiagonal matrix. Truncated() builds a rank-k
+// approximation with a randomized range finder instead
+class S21SVD {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21SVD(const S21Matrix& matrix);
+
+  /* ======================== Accessors and mutatos ========================= */
+  const std::vector<double>& GetSingularValues() const noexcept;
+  const S21Matrix& GetU() const noexcept;
+  const S21Matrix& GetV() const noexcept;
+
+  /* ============================== Functions =============================== */
+  int Rank(double tolerance = -1) const noexcept;
+  double ConditionNumber() const noexcept;
+  S21Matrix PseudoInverse(double tolerance = -1) const;
+  S21Matrix Reconstruct() const;
+  static S21SVD Truncated(const S21Matrix& matrix, int rank,
+                          int oversampling = 10, int power_iterations = 2);
+
+ private:
+  /* ============================= Attributes =============================== */
+  std::vector<double> values_;
+  S21Matrix u_;
+  S21Matrix v_;
+
+  /* ===================== Constructors and destructors ===================== */
+  S21SVD() = default;
+
+  /* ============================== Methods ================================= */
+  void Decompose(const S21Matrix& matrix);
+  double DefaultTolerance() const noexcept;
+};
+
+#endif  // S21_SVD_H
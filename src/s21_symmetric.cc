@@ -0,0 +1,265 @@
+#include "s21_symmetric.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "s21_gemm.h"
+#include "s21_thread_pool.h"
+
+// Rows of the result computed by one task, the part of the rows left of the
+// diagonal block is a rectangle that goes to GEMM
+static constexpr int kBlock = 64;
+// Updates smaller than this number of multiplications run on one thread
+static constexpr long long kParallelWork = 64LL * 64 * 64;
+// Elements passed to one S21Axpy call, which takes an int size, so packed
+// arrays of orders above 65535 are added in pieces
+static constexpr size_t kAxpyChunk = size_t{1} << 20;
+
+// Adds alpha * x to y over packed arrays of equal length, chunk by chunk
+static void PackedAxpy(double alpha, const std::vector<double> &x,
+                       std::vector<double> &y) noexcept {
+  for (size_t first = 0; first < y.size(); first += kAxpyChunk) {
+    const size_t count = std::min(kAxpyChunk, y.size() - first);
+    S21Axpy(alpha, x.data() + first, y.data() + first,
+            static_cast<int>(count));
+  }
+}
+
+// Default constructor
+S21SymmetricMatrix::S21SymmetricMatrix() noexcept : size_{} {}
+
+// Creates a zero symmetric matrix of the given order
+S21SymmetricMatrix::S21SymmetricMatrix(int size) {
+  if (size < 1) {
+    throw std::invalid_argument("Size can't be less than 1");
+  }
+  size_ = size;
+  packed_.assign(static_cast<size_t>(size_) * (size_ + 1) / 2, 0.0);
+}
+
+// Copies the lower triangle of a square matrix, the upper one is not read
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix &matrix)
+    : S21SymmetricMatrix(matrix.GetRows()) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("The matrix is not square");
+  }
+  for (int i = 0; i < size_; i++) {
+    std::copy(matrix.matrix_[i], matrix.matrix_[i] + i + 1,
+              packed_.begin() + Index(i, 0));
+  }
+}
+
+// Returns the order of the matrix
+int S21SymmetricMatrix::GetSize() const noexcept { return size_; }
+
+// Returns the position of the element in the packed lower triangle
+size_t S21SymmetricMatrix::Index(int row, int col) const noexcept {
+  if (col > row) std::swap(row, col);
+  return static_cast<size_t>(row) * (row + 1) / 2 + col;
+}
+
+// Returns op(A) * op(A)^T (SYRK), only the lower triangle is computed, which
+// is half the work of a general product
+S21SymmetricMatrix S21SymmetricMatrix::Syrk(const S21Matrix &a, Trans trans) {
+  S21SymmetricMatrix result(trans == Trans::kNoTrans ? a.rows_ : a.cols_);
+  result.RankUpdate(a, a, trans, false);
+  return result;
+}
+
+// Returns op(A) * op(B)^T + op(B) * op(A)^T (SYR2K), only the lower triangle
+// is computed
+S21SymmetricMatrix S21SymmetricMatrix::Syr2k(const S21Matrix &a,
+                                             const S21Matrix &b, Trans trans) {
+  if (a.rows_ != b.rows_ || a.cols_ != b.cols_) {
+    throw std::invalid_argument("Matrices have different sizes");
+  }
+  S21SymmetricMatrix result(trans == Trans::kNoTrans ? a.rows_ : a.cols_);
+  result.RankUpdate(a, b, trans, true);
+  return result;
+}
+
+// Adds rows [from, to) and columns [col_from, col_to) of op(X) * op(Y)^T to
+// c, the row pointers of the block. Both cases read the operands in place:
+// with kNoTrans the elements are dot products of rows, with kTrans the
+// columns of X are walked by the transposed GEMM kernel
+void S21SymmetricMatrix::AddProduct(const S21Matrix &x, const S21Matrix &y,
+                                    Trans trans, int from, int to,
+                                    int col_from, int col_to, double **c) {
+  if (trans == Trans::kNoTrans) {
+    S21GemmNT(to - from, col_to - col_from, x.cols_, x.matrix_ + from,
+              y.matrix_ + col_from, c);
+    return;
+  }
+  std::vector<const double *> left(x.rows_), right(y.rows_);
+  for (int p = 0; p < x.rows_; p++) {
+    left[p] = x.matrix_[p] + from;
+    right[p] = y.matrix_[p] + col_from;
+  }
+  S21GemmTN(to - from, col_to - col_from, x.rows_, left.data(), right.data(),
+            c);
+}
+
+// Adds op(X) * op(Y)^T, and op(Y) * op(X)^T when both is set, to the lower
+// triangle. Blocks of rows are independent tasks: the rectangle left of the
+// diagonal block is accumulated straight into the packed rows, the diagonal
+// block goes through a small square buffer whose lower half is kept. The
+// longest block rows are handed out first to balance the threads
+void S21SymmetricMatrix::RankUpdate(const S21Matrix &x, const S21Matrix &y,
+                                    Trans trans, bool both) {
+  std::vector<double *> rows(size_);
+  for (int i = 0; i < size_; i++) {
+    rows[i] = packed_.data() + Index(i, 0);
+  }
+  const int depth = trans == Trans::kNoTrans ? x.cols_ : x.rows_;
+  const int blocks = (size_ + kBlock - 1) / kBlock;
+  const long long work = static_cast<long long>(size_) * size_ * depth / 2;
+  S21ThreadPool::Instance().ParallelFor(
+      0, blocks, work < kParallelWork ? blocks : 1, [&](int begin, int end) {
+        std::vector<double> scratch(kBlock * kBlock);
+        std::vector<double *> tile(kBlock);
+        for (int i = 0; i < kBlock; i++) {
+          tile[i] = scratch.data() + i * kBlock;
+        }
+        for (int block = begin; block < end; block++) {
+          const int from = (blocks - 1 - block) * kBlock;
+          const int to = std::min(size_, from + kBlock);
+          std::fill(scratch.begin(), scratch.end(), 0.0);
+          AddProduct(x, y, trans, from, to, 0, from, rows.data() + from);
+          AddProduct(x, y, trans, from, to, from, to, tile.data());
+          if (both) {
+            AddProduct(y, x, trans, from, to, 0, from, rows.data() + from);
+            AddProduct(y, x, trans, from, to, from, to, tile.data());
+          }
+          for (int i = from; i < to; i++) {
+            for (int j = from; j <= i; j++) {
+              rows[i][j] += tile[i - from][j - from];
+            }
+          }
+        }
+      });
+}
+
+// Checks if the matrices are equal, the stored triangles are compared
+bool S21SymmetricMatrix::EqMatrix(
+    const S21SymmetricMatrix &other) const noexcept {
+  if (size_ != other.size_) {
+    return false;
+  }
+  for (size_t i = 0; i < packed_.size(); i++) {
+    if (fabs(packed_[i] - other.packed_[i]) >= 1.0e-07) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Adds the given matrix, only the stored triangle is touched
+void S21SymmetricMatrix::SumMatrix(const S21SymmetricMatrix &other) {
+  CheckIfSizesAreEqual(other);
+  PackedAxpy(1.0, other.packed_, packed_);
+}
+
+// Subtracts the given matrix, only the stored triangle is touched
+void S21SymmetricMatrix::SubMatrix(const S21SymmetricMatrix &other) {
+  CheckIfSizesAreEqual(other);
+  PackedAxpy(-1.0, other.packed_, packed_);
+}
+
+// Multiplies the stored triangle by the number
+void S21SymmetricMatrix::MulNumber(const double num) noexcept {
+  for (double &value : packed_) {
+    value *= num;
+  }
+}
+
+// Returns the matrix in dense storage with both triangles filled
+S21Matrix S21SymmetricMatrix::ToMatrix() const {
+  S21Matrix dense(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    const double *row = packed_.data() + Index(i, 0);
+    for (int j = 0; j <= i; j++) {
+      dense.matrix_[i][j] = row[j];
+      dense.matrix_[j][i] = row[j];
+    }
+  }
+  return dense;
+}
+
+// Checks if the matrices have the same order
+void S21SymmetricMatrix::CheckIfSizesAreEqual(
+    const S21SymmetricMatrix &other) const {
+  if (size_ != other.size_) {
+    throw std::invalid_argument("Matrices have different sizes");
+  }
+}
+
+// Checks if the element is inside the matrix
+void S21SymmetricMatrix::CheckIfIndexExists(int row, int col) const {
+  if (row < 0 || col < 0) {
+    throw std::out_of_range("Row or column can't be less than zero");
+  } else if (row >= size_ || col >= size_) {
+    throw std::out_of_range("Row or column doesn't exist");
+  }
+}
+
+// Returns the sum of two matrices
+S21SymmetricMatrix S21SymmetricMatrix::operator+(
+    const S21SymmetricMatrix &other) const {
+  S21SymmetricMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+// Returns the difference of two matrices
+S21SymmetricMatrix S21SymmetricMatrix::operator-(
+    const S21SymmetricMatrix &other) const {
+  S21SymmetricMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+// Returns the matrix multiplied by the number
+S21SymmetricMatrix S21SymmetricMatrix::operator*(const double num) const {
+  S21SymmetricMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+// Checks if the matrices are equal
+bool S21SymmetricMatrix::operator==(
+    const S21SymmetricMatrix &other) const noexcept {
+  return EqMatrix(other);
+}
+
+// Adds the given matrix to the current matrix
+S21SymmetricMatrix &S21SymmetricMatrix::operator+=(
+    const S21SymmetricMatrix &other) {
+  SumMatrix(other);
+  return *this;
+}
+
+// Subtracts the given matrix from the current matrix
+S21SymmetricMatrix &S21SymmetricMatrix::operator-=(
+    const S21SymmetricMatrix &other) {
+  SubMatrix(other);
+  return *this;
+}
+
+// Multiplies the current matrix by the number
+S21SymmetricMatrix &S21SymmetricMatrix::operator*=(const double num) noexcept {
+  MulNumber(num);
+  return *this;
+}
+
+// Returns the element at the specified row and column, (row, col) and
+// (col, row) are the same element
+double &S21SymmetricMatrix::operator()(int row, int col) {
+  CheckIfIndexExists(row, col);
+  return packed_[Index(row, col)];
+}
+
+// Returns the element at the specified row and column
+double S21SymmetricMatrix::operator()(int row, int col) const {
+  CheckIfIndexExists(row, col);
+  return packed_[Index(row, col)];
+}
@@ -0,0 +1,63 @@
+#ifndef S21_SYMMETRIC_H
+#define S21_SYMMETRIC_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Symmetric matrix in packed storage: only the lower triangle is kept, row
+// after row, so the matrix takes n * (n + 1) / 2 elements. Row i of the lower
+// triangle is column i of the upper one, so (row, col) and (col, row) address
+// the same element and both triangles are served by one layout
+class S21SymmetricMatrix {
+ public:
+  // Selects op(A) in the rank-k updates: kNoTrans gives A * A^T, kTrans gives
+  // A^T * A without forming the transpose
+  enum class Trans { kNoTrans, kTrans };
+
+  /* ===================== Constructors and destructors ===================== */
+  S21SymmetricMatrix() noexcept;
+  explicit S21SymmetricMatrix(int size);
+  explicit S21SymmetricMatrix(const S21Matrix& matrix);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+
+  /* ============================== Functions =============================== */
+  static S21SymmetricMatrix Syrk(const S21Matrix& a, Trans trans);
+  static S21SymmetricMatrix Syr2k(const S21Matrix& a, const S21Matrix& b,
+                                  Trans trans);
+  bool EqMatrix(const S21SymmetricMatrix& other) const noexcept;
+  void SumMatrix(const S21SymmetricMatrix& other);
+  void SubMatrix(const S21SymmetricMatrix& other);
+  void MulNumber(const double num) noexcept;
+  S21Matrix ToMatrix() const;
+
+  /* ============================== Operators =============================== */
+  S21SymmetricMatrix operator+(const S21SymmetricMatrix& other) const;
+  S21SymmetricMatrix operator-(const S21SymmetricMatrix& other) const;
+  S21SymmetricMatrix operator*(const double num) const;
+  bool operator==(const S21SymmetricMatrix& other) const noexcept;
+  S21SymmetricMatrix& operator+=(const S21SymmetricMatrix& other);
+  S21SymmetricMatrix& operator-=(const S21SymmetricMatrix& other);
+  S21SymmetricMatrix& operator*=(const double num) noexcept;
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  int size_;
+  std::vector<double> packed_;
+
+  /* ============================== Methods ================================= */
+  size_t Index(int row, int col) const noexcept;
+  void RankUpdate(const S21Matrix& x, const S21Matrix& y, Trans trans,
+                  bool both);
+  static void AddProduct(const S21Matrix& x, const S21Matrix& y, Trans trans,
+                         int from, int to, int col_from, int col_to,
+                         double** c);
+  void CheckIfIndexExists(int row, int col) const;
+  void CheckIfSizesAreEqual(const S21SymmetricMatrix& other) const;
+};
+
+#endif  // S21_SYMMETRIC_H
@@ -0,0 +1,168 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+
+// Creates a pool running the given number of threads in total, the thread that
+// calls ParallelFor always takes part in the work, so threads - 1 workers are
+// started
+S21ThreadPool::S21ThreadPool(int threads) : stopping_(false) {
+  if (threads < 1) {
+    throw std::invalid_argument("Thread count can't be less than 1");
+  }
+  StartWorkers(threads);
+}
+
+// Destructor, waits for the workers to finish the queued tasks
+S21ThreadPool::~S21ThreadPool() { StopWorkers(); }
+
+// Returns the pool shared by all matrix operations
+S21ThreadPool& S21ThreadPool::Instance() {
+  static S21ThreadPool pool(
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+  return pool;
+}
+
+// Returns the number of threads taking part in parallel loops
+int S21ThreadPool::GetThreadCount() const noexcept {
+  return static_cast<int>(workers_.size()) + 1;
+}
+
+// Restarts the pool with another number of threads, must not be called while
+// the pool is busy
+void S21ThreadPool::SetThreadCount(int threads) {
+  if (threads < 1) {
+    throw std::invalid_argument("Thread count can't be less than 1");
+  }
+  StopWorkers();
+  StartWorkers(threads);
+}
+
+// Starts threads - 1 workers
+void S21ThreadPool::StartWorkers(int threads) {
+  stopping_ = false;
+  for (int i = 1; i < threads; i++) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this);
+  }
+}
+
+// Lets the workers drain the queue and joins them
+void S21ThreadPool::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  ready_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+// Takes tasks from the queue until the pool is stopped
+void S21ThreadPool::WorkerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) return;
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+// Queues a task for the workers, runs it in place if there are no workers
+void S21ThreadPool::Post(std::function<void()> task) {
+  if (workers_.empty()) {
+    task();
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+  ready_.notify_one();
+}
+
+// Runs queued tasks on the calling thread until done returns true, so a
+// thread waiting for other tasks keeps the pool busy instead of sleeping.
+// done is checked under the pool lock and must not post tasks; whoever makes
+// it true calls Wake afterwards
+void S21ThreadPool::HelpUntil(const std::function<bool()>& done) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!done()) {
+    if (tasks_.empty()) {
+      ready_.wait(lock);
+      continue;
+    }
+    std::function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
+
+// Wakes the workers and the threads in HelpUntil to check their conditions
+void S21ThreadPool::Wake() {
+  { std::lock_guard<std::mutex> lock(mutex_); }
+  ready_.notify_all();
+}
+
+// Calls body(chunk_begin, chunk_end) for chunks of at least grain iterations
+// covering [begin, end). The caller works on the chunks too and only waits for
+// the chunks already taken by workers, so nested parallel loops can't deadlock.
+// The first exception thrown by the body is rethrown in the caller
+void S21ThreadPool::ParallelFor(int begin, int end, int grain,
+                                const std::function<void(int, int)>& body) {
+  if (end <= begin) return;
+  grain = std::max(grain, 1);
+  const int threads = GetThreadCount();
+  if (threads == 1 || end - begin <= grain) {
+    body(begin, end);
+    return;
+  }
+  const int chunks =
+      std::min((end - begin + grain - 1) / grain, threads * 4);
+  const int step = (end - begin + chunks - 1) / chunks;
+
+  struct Loop {
+    std::atomic<int> next{0};
+    std::atomic<int> done{0};
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+  };
+  auto loop = std::make_shared<Loop>();
+  // The body is only referenced while chunks remain, and the caller doesn't
+  // return before every taken chunk is done
+  auto run = [loop, &body, begin, end, step, chunks] {
+    for (int chunk = loop->next++; chunk < chunks; chunk = loop->next++) {
+      const int from = begin + chunk * step;
+      const int to = std::min(end, from + step);
+      try {
+        if (from < to) body(from, to);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        if (!loop->error) loop->error = std::current_exception();
+      }
+      if (++loop->done == chunks) {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        loop->finished.notify_all();
+      }
+    }
+  };
+  for (int i = 1; i < std::min(threads, chunks); i++) {
+    Post(run);
+  }
+  run();
+  std::unique_lock<std::mutex> lock(loop->mutex);
+  loop->finished.wait(lock, [&loop, chunks] { return loop->done == chunks; });
+  if (loop->error) std::rethrow_exception(loop->error);
+}
@@ -0,0 +1,45 @@
+#ifndef S21_THREAD_POOL_H
+#define S21_THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class S21ThreadPool {
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  explicit S21ThreadPool(int threads);
+  ~S21ThreadPool();
+  S21ThreadPool(const S21ThreadPool& other) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool& other) = delete;
+
+  /* ======================== Accessors and mutatos ========================= */
+  static S21ThreadPool& Instance();
+  int GetThreadCount() const noexcept;
+  void SetThreadCount(int threads);
+
+  /* ============================== Functions =============================== */
+  void Post(std::function<void()> task);
+  void ParallelFor(int begin, int end, int grain,
+                   const std::function<void(int, int)>& body);
+  void HelpUntil(const std::function<bool()>& done);
+  void Wake();
+
+ private:
+  /* ============================= Attributes =============================== */
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool stopping_;
+
+  /* ============================== Methods ================================= */
+  void StartWorkers(int threads);
+  void StopWorkers();
+  void WorkerLoop();
+};
+
+#endif  // S21_THREAD_POOL_H
@@ -0,0 +1,206 @@
+#include "s21_triangular.h"
+
+#include <algorithm>
+
+#include "s21_gemm.h"
+
+// Rows of the triangle solved or multiplied at once, the part of the triangle
+// outside the diagonal blocks is handled by GEMM
+static constexpr int kBlock = 64;
+
+// Default constructor
+S21TriangularMatrix::S21TriangularMatrix() noexcept
+    : size_{}, uplo_(Uplo::kLower) {}
+
+// Creates a zero triangular matrix of the given order
+S21TriangularMatrix::S21TriangularMatrix(int size, Uplo uplo) : uplo_(uplo) {
+  if (size < 1) {
+    throw std::invalid_argument("Size can't be less than 1");
+  }
+  size_ = size;
+  packed_.assign(static_cast<size_t>(size_) * (size_ + 1) / 2, 0.0);
+}
+
+// Copies the triangle of a square matrix, the other elements are dropped
+S21TriangularMatrix::S21TriangularMatrix(const S21Matrix &matrix, Uplo uplo)
+    : S21TriangularMatrix(matrix.GetRows(), uplo) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("The matrix is not square");
+  }
+  for (int i = 0; i < size_; i++) {
+    const int first = uplo_ == Uplo::kLower ? 0 : i;
+    const int last = uplo_ == Uplo::kLower ? i : size_ - 1;
+    std::copy(matrix.matrix_[i] + first, matrix.matrix_[i] + last + 1,
+              packed_.begin() + RowOffset(i) + first);
+  }
+}
+
+// Returns the order of the matrix
+int S21TriangularMatrix::GetSize() const noexcept { return size_; }
+
+// Returns which triangle is stored
+S21TriangularMatrix::Uplo S21TriangularMatrix::GetUplo() const noexcept {
+  return uplo_;
+}
+
+// Checks if the element belongs to the stored triangle
+bool S21TriangularMatrix::InTriangle(int row, int col) const noexcept {
+  return uplo_ == Uplo::kLower ? col <= row : col >= row;
+}
+
+// Returns the index of the element (row, 0) in the packed storage, the
+// elements of the row are at that index plus the column. Row i of the lower
+// triangle starts at column 0, row i of the upper triangle starts at column i
+// after the n + (n - 1) + ... + (n - i + 1) elements of the rows above
+size_t S21TriangularMatrix::RowOffset(int row) const noexcept {
+  const size_t i = row;
+  return uplo_ == Uplo::kLower ? i * (i + 1) / 2
+                               : i * size_ - i * (i - 1) / 2 - i;
+}
+
+// Returns a pointer per row such that rows[i][j] is the element (i, j) for
+// every j of the triangle
+std::vector<const double *> S21TriangularMatrix::Rows() const {
+  std::vector<const double *> rows(size_);
+  for (int i = 0; i < size_; i++) {
+    rows[i] = packed_.data() + RowOffset(i);
+  }
+  return rows;
+}
+
+// The determinant of a triangular matrix is the product of its diagonal
+double S21TriangularMatrix::Determinant() const noexcept {
+  const std::vector<const double *> rows = Rows();
+  double product = 1;
+  for (int i = 0; i < size_; i++) {
+    product *= rows[i][i];
+  }
+  return product;
+}
+
+// Checks if the matrix can solve the system or multiply the matrix
+void S21TriangularMatrix::CheckRhs(const S21Matrix &rhs) const {
+  if (rhs.rows_ != size_) {
+    throw std::invalid_argument(
+        "Right-hand side rows are not equal to the matrix size");
+  }
+}
+
+// Solves T * X = rhs for every column of rhs (TRSM). The rows are processed
+// in blocks in the order of substitution: a diagonal block is solved row by
+// row, then its contribution is removed from all remaining rows at once by
+// GEMM with alpha = -1
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix &rhs) const {
+  CheckRhs(rhs);
+  const std::vector<const double *> rows = Rows();
+  for (int i = 0; i < size_; i++) {
+    if (rows[i][i] == 0) {
+      throw std::logic_error("The matrix is singular");
+    }
+  }
+  const int n = size_, k = rhs.cols_;
+  const bool lower = uplo_ == Uplo::kLower;
+  S21Matrix solution(rhs);
+  solution.Detach();
+  double **x = solution.matrix_;
+  std::vector<const double *> panel;
+  for (int block = 0; block < n; block += kBlock) {
+    // Rows [from, to) are solved now, rows [rest_from, rest_to) wait
+    const int from = lower ? block : std::max(0, n - block - kBlock);
+    const int to = lower ? std::min(n, block + kBlock) : n - block;
+    for (int step = 0; step < to - from; step++) {
+      const int i = lower ? from + step : to - 1 - step;
+      const int first = lower ? from : i + 1;
+      const int last = lower ? i : to;
+      for (int t = first; t < last; t++) {
+        S21Axpy(-rows[i][t], x[t], x[i], k);
+      }
+      const double inverse = 1.0 / rows[i][i];
+      for (int c = 0; c < k; c++) {
+        x[i][c] *= inverse;
+      }
+    }
+    const int rest_from = lower ? to : 0;
+    const int rest_to = lower ? n : from;
+    panel.clear();
+    for (int i = rest_from; i < rest_to; i++) {
+      panel.push_back(rows[i] + from);
+    }
+    S21Gemm(rest_to - rest_from, k, to - from, panel.data(), x + from,
+            x + rest_from, -1.0);
+  }
+  solution.Touch();
+  return solution;
+}
+
+// Returns T * other (TRMM). For every block of rows the part of the triangle
+// left (lower) or right (upper) of the diagonal block is a rectangle that goes
+// to GEMM, the diagonal block is added row by row
+S21Matrix S21TriangularMatrix::Multiply(const S21Matrix &other) const {
+  CheckRhs(other);
+  const std::vector<const double *> rows = Rows();
+  const int n = size_, k = other.cols_;
+  const bool lower = uplo_ == Uplo::kLower;
+  S21Matrix product(n, k);
+  double **b = other.matrix_, **c = product.matrix_;
+  std::vector<const double *> panel;
+  for (int from = 0; from < n; from += kBlock) {
+    const int to = std::min(n, from + kBlock);
+    const int depth_from = lower ? 0 : to;
+    const int depth_to = lower ? from : n;
+    panel.clear();
+    for (int i = from; i < to; i++) {
+      panel.push_back(rows[i] + depth_from);
+    }
+    S21Gemm(to - from, k, depth_to - depth_from, panel.data(), b + depth_from,
+            c + from);
+    for (int i = from; i < to; i++) {
+      const int first = lower ? from : i;
+      const int last = lower ? i : to - 1;
+      for (int t = first; t <= last; t++) {
+        S21Axpy(rows[i][t], b[t], c[i], k);
+      }
+    }
+  }
+  return product;
+}
+
+// Returns the matrix in dense storage
+S21Matrix S21TriangularMatrix::ToMatrix() const {
+  S21Matrix dense(size_, size_);
+  const std::vector<const double *> rows = Rows();
+  for (int i = 0; i < size_; i++) {
+    const int first = uplo_ == Uplo::kLower ? 0 : i;
+    const int last = uplo_ == Uplo::kLower ? i : size_ - 1;
+    std::copy(rows[i] + first, rows[i] + last + 1, dense.matrix_[i] + first);
+  }
+  return dense;
+}
+
+// Checks if the element is inside the matrix and its triangle
+void S21TriangularMatrix::CheckIfIndexExists(int row, int col) const {
+  if (row < 0 || col < 0) {
+    throw std::out_of_range("Row or column can't be less than zero");
+  } else if (row >= size_ || col >= size_) {
+    throw std::out_of_range("Row or column doesn't exist");
+  } else if (!InTriangle(row, col)) {
+    throw std::out_of_range("The element is outside of the triangle");
+  }
+}
+
+// Returns the element of the triangle at the specified row and column
+double &S21TriangularMatrix::operator()(int row, int col) {
+  CheckIfIndexExists(row, col);
+  return packed_[RowOffset(row) + col];
+}
+
+// Returns the element at the specified row and column, zero outside the
+// triangle
+double S21TriangularMatrix::operator()(int row, int col) const {
+  if (row >= 0 && col >= 0 && row < size_ && col < size_ &&
+      !InTriangle(row, col)) {
+    return 0;
+  }
+  CheckIfIndexExists(row, col);
+  return packed_[RowOffset(row) + col];
+}
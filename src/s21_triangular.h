@@ -0,0 +1,49 @@
+#ifndef S21_TRIANGULAR_H
+#define S21_TRIANGULAR_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Lower or upper triangular matrix in packed storage: only the n * (n + 1) / 2
+// elements of the triangle are kept, row after row. Every row of the triangle
+// is contiguous, so the solve (TRSM) and product (TRMM) kernels hand rows
+// straight to the blocked GEMM kernel
+class S21TriangularMatrix {
+ public:
+  enum class Uplo { kLower, kUpper };
+
+  /* ===================== Constructors and destructors ===================== */
+  S21TriangularMatrix() noexcept;
+  S21TriangularMatrix(int size, Uplo uplo);
+  S21TriangularMatrix(const S21Matrix& matrix, Uplo uplo);
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  Uplo GetUplo() const noexcept;
+
+  /* ============================== Functions =============================== */
+  double Determinant() const noexcept;
+  S21Matrix Solve(const S21Matrix& rhs) const;
+  S21Matrix Multiply(const S21Matrix& other) const;
+  S21Matrix ToMatrix() const;
+
+  /* ============================== Operators =============================== */
+  double& operator()(int row, int col);
+  double operator()(int row, int col) const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  int size_;
+  Uplo uplo_;
+  std::vector<double> packed_;
+
+  /* ============================== Methods ================================= */
+  bool InTriangle(int row, int col) const noexcept;
+  size_t RowOffset(int row) const noexcept;
+  std::vector<const double*> Rows() const;
+  void CheckIfIndexExists(int row, int col) const;
+  void CheckRhs(const S21Matrix& rhs) const;
+};
+
+#endif  // S21_TRIANGULAR_H
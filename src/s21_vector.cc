@@ -0,0 +1,163 @@
+#include "s21_vector.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "s21_gemm.h"
+
+// Default constructor
+S21Vector::S21Vector() noexcept : size_{}, data_{} {}
+
+// Parameterized constructor, every element is zero
+S21Vector::S21Vector(int size) {
+  if (size < 1) {
+    throw std::invalid_argument("Size can't be less than 1");
+  }
+  size_ = size;
+  data_ = new double[size_]();
+}
+
+// Creates a vector from a matrix with one column
+S21Vector::S21Vector(const S21Matrix &column) : S21Vector(column.rows_) {
+  if (column.cols_ != 1) {
+    throw std::invalid_argument("The matrix must have exactly one column");
+  }
+  for (int i = 0; i < size_; i++) {
+    data_[i] = column.matrix_[i][0];
+  }
+}
+
+// Destructor
+S21Vector::~S21Vector() { delete[] data_; }
+
+// Copy constructor
+S21Vector::S21Vector(const S21Vector &other) : size_(other.size_) {
+  if (&other == this) {
+    throw std::logic_error("Self-copying is not allowed");
+  }
+  data_ = size_ ? new double[size_] : nullptr;
+  std::copy(other.data_, other.data_ + size_, data_);
+}
+
+// Move constructor
+S21Vector::S21Vector(S21Vector &&other) noexcept
+    : size_(std::exchange(other.size_, 0)),
+      data_(std::exchange(other.data_, nullptr)) {}
+
+// Returns the number of elements
+int S21Vector::GetSize() const noexcept { return size_; }
+
+// Returns the contiguous storage of the elements
+double *S21Vector::Data() noexcept { return data_; }
+
+// Returns the contiguous storage of the elements
+const double *S21Vector::Data() const noexcept { return data_; }
+
+// Checks if sizes of the vectors are equal
+void S21Vector::CheckIfSizesAreEqual(const S21Vector &other) const {
+  if (size_ != other.size_) {
+    throw std::invalid_argument("Sizes of vectors are not equal");
+  }
+}
+
+// Checks if the vectors are equal with the accuracy of S21Matrix::EqMatrix
+bool S21Vector::EqVector(const S21Vector &other) const noexcept {
+  if (size_ != other.size_) return false;
+  for (int i = 0; i < size_; i++) {
+    // 1.0e-07 is 10 * 10 ^ (-7)
+    if (fabs(data_[i] - other.data_[i]) >= 1.0e-07) return false;
+  }
+  return true;
+}
+
+// Returns the dot product of the vectors
+double S21Vector::Dot(const S21Vector &other) const {
+  CheckIfSizesAreEqual(other);
+  return S21Dot(data_, other.data_, size_);
+}
+
+// Adds the given vector multiplied by alpha to the current vector
+void S21Vector::Axpy(double alpha, const S21Vector &other) {
+  CheckIfSizesAreEqual(other);
+  S21Axpy(alpha, other.data_, data_, size_);
+}
+
+// Multiplies the vector by a number
+void S21Vector::MulNumber(double num) noexcept {
+  for (int i = 0; i < size_; i++) {
+    data_[i] *= num;
+  }
+}
+
+// Returns the euclidean norm, the sum of squares is scaled by the largest
+// element so it can't overflow or underflow
+double S21Vector::Norm() const noexcept {
+  double largest = 0;
+  for (int i = 0; i < size_; i++) {
+    largest = std::max(largest, fabs(data_[i]));
+  }
+  if (largest == 0) return 0;
+  double sum = 0;
+  const double inverse = 1.0 / largest;
+  for (int i = 0; i < size_; i++) {
+    const double scaled = data_[i] * inverse;
+    sum += scaled * scaled;
+  }
+  return largest * sqrt(sum);
+}
+
+// Returns the vector as a matrix with one column
+S21Matrix S21Vector::ToMatrix() const {
+  S21Matrix column(size_, 1);
+  for (int i = 0; i < size_; i++) {
+    column.matrix_[i][0] = data_[i];
+  }
+  return column;
+}
+
+// Checks if the vectors are equal
+bool S21Vector::operator==(const S21Vector &other) const noexcept {
+  return EqVector(other);
+}
+
+// Copy assignment operator
+S21Vector &S21Vector::operator=(const S21Vector &other) {
+  if (this == &other) {
+    return *this;
+  }
+  S21Vector copy(other);
+  *this = std::move(copy);
+  return *this;
+}
+
+// Move assignment operator
+S21Vector &S21Vector::operator=(S21Vector &&other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+  delete[] data_;
+  size_ = std::exchange(other.size_, 0);
+  data_ = std::exchange(other.data_, nullptr);
+  return *this;
+}
+
+// Returns a pointer to the element with the given index
+double &S21Vector::operator()(int index) {
+  CheckIfIndexExists(index);
+  return data_[index];
+}
+
+// Returns a read-only pointer to the element with the given index
+const double &S21Vector::operator()(int index) const {
+  CheckIfIndexExists(index);
+  return data_[index];
+}
+
+// Checks if the index is valid for the vector
+void S21Vector::CheckIfIndexExists(int index) const {
+  if (index < 0) {
+    throw std::out_of_range("Index can't be less than zero");
+  } else if (index >= size_) {
+    throw std::out_of_range("Index doesn't exist");
+  }
+}
@@ -0,0 +1,51 @@
+#ifndef S21_VECTOR_H
+#define S21_VECTOR_H
+
+#include "s21_matrix_oop.h"
+
+// Dense vector stored in one contiguous block. It is the operand of the
+// matrix-vector kernels of S21Matrix (MulVector, MulVectorTransposed and
+// RankOneUpdate) and of the level 1 operations below
+class S21Vector {
+  friend class S21Matrix;
+
+ public:
+  /* ===================== Constructors and destructors ===================== */
+  S21Vector() noexcept;
+  explicit S21Vector(int size);
+  explicit S21Vector(const S21Matrix& column);
+  ~S21Vector();
+  S21Vector(const S21Vector& other);
+  S21Vector(S21Vector&& other) noexcept;
+
+  /* ======================== Accessors and mutatos ========================= */
+  int GetSize() const noexcept;
+  double* Data() noexcept;
+  const double* Data() const noexcept;
+
+  /* ============================== Functions =============================== */
+  bool EqVector(const S21Vector& other) const noexcept;
+  double Dot(const S21Vector& other) const;
+  void Axpy(double alpha, const S21Vector& other);
+  void MulNumber(double num) noexcept;
+  double Norm() const noexcept;
+  S21Matrix ToMatrix() const;
+
+  /* ============================== Operators =============================== */
+  bool operator==(const S21Vector& other) const noexcept;
+  S21Vector& operator=(const S21Vector& other);
+  S21Vector& operator=(S21Vector&& other) noexcept;
+  double& operator()(int index);
+  const double& operator()(int index) const;
+
+ private:
+  /* ============================= Attributes =============================== */
+  int size_;
+  double* data_;
+
+  /* ============================== Methods ================================= */
+  void CheckIfSizesAreEqual(const S21Vector& other) const;
+  void CheckIfIndexExists(int index) const;
+};
+
+#endif  // S21_VECTOR_H
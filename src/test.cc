@@ -1,6 +1,26 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <limits>
+
+#include "s21_async.h"
+#include "s21_band.h"
+#include "s21_bit_matrix.h"
+#include "s21_chain.h"
+#include "s21_cholesky.h"
+#include "s21_eigen.h"
+#include "s21_gemm.h"
+#include "s21_graph.h"
+#include "s21_lu.h"
+#include "s21_memory.h"
 #include "s21_matrix_oop.h"
+#include "s21_mixed_lu.h"
+#include "s21_qr.h"
+#include "s21_svd.h"
+#include "s21_symmetric.h"
+#include "s21_thread_pool.h"
+#include "s21_triangular.h"
+#include "s21_vector.h"
 
 /* ===================== Constructors and destructors ===================== */
 
@@ -783,6 +803,13 @@ TEST(DeterminantTest, NonSquareMatrix) {
   EXPECT_THROW(mat.Determinant(), std::logic_error);
 }
 
+TEST(DeterminantTest, EmptyMatrix) {
+  const S21Matrix empty;
+  EXPECT_TRUE(empty.IsUpperTriangular());
+  EXPECT_EQ(empty.Determinant(), 0);
+  EXPECT_EQ(empty.Determinant(), 0);
+}
+
 TEST(InverseMatrixTest, test1) {
   double matrix[3][3] = {{2, 5, 7}, {6, 3, 4}, {5, -2, -3}};
   double matrix_throw[3][3] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
@@ -1642,6 +1669,1770 @@ TEST(OperatorParentheses, AccessNonexistentElement) {
       std::out_of_range);
 }
 
+/* ============================ Cached results ============================ */
+
+TEST(CachedResults, VersionChangesOnMutation) {
+  S21Matrix mat(2, 2);
+  unsigned long long version = mat.GetVersion();
+  mat(0, 0) = 1;
+  EXPECT_NE(mat.GetVersion(), version);
+  version = mat.GetVersion();
+  mat.SumMatrix(S21Matrix(2, 2));
+  EXPECT_NE(mat.GetVersion(), version);
+  version = mat.GetVersion();
+  mat.MulNumber(2);
+  EXPECT_NE(mat.GetVersion(), version);
+  version = mat.GetVersion();
+  mat.SetRows(3);
+  EXPECT_NE(mat.GetVersion(), version);
+  version = mat.GetVersion();
+  const S21Matrix &view = mat;
+  EXPECT_EQ(view(0, 0), 2);
+  EXPECT_EQ(mat.GetVersion(), version);
+}
+
+TEST(CachedResults, DeterminantInvalidatedByWrite) {
+  S21Matrix mat(2, 2);
+  mat(0, 0) = 1;
+  mat(0, 1) = 2;
+  mat(1, 0) = 3;
+  mat(1, 1) = 4;
+  EXPECT_EQ(mat.Determinant(), -2);
+  EXPECT_EQ(mat.Determinant(), -2);
+  mat(1, 1) = 6;
+  EXPECT_EQ(mat.Determinant(), 0);
+  mat *= 2.0;
+  EXPECT_EQ(mat.Determinant(), 0);
+  mat(0, 0) = 4;
+  EXPECT_EQ(mat.Determinant(), 24);
+}
+
+TEST(CachedResults, Norms) {
+  S21Matrix m(2, 2);
+  m(0, 0) = 3;
+  m(1, 1) = -4;
+  EXPECT_DOUBLE_EQ(m.Norm(), 5);
+  EXPECT_DOUBLE_EQ(m.Norm(S21Matrix::NormType::kMax), 4);
+  EXPECT_DOUBLE_EQ(m.Norm(), 5);
+  const S21Matrix copy(m);
+  m(0, 1) = 12;
+  EXPECT_DOUBLE_EQ(m.Norm(), 13);
+  EXPECT_DOUBLE_EQ(m.Norm(S21Matrix::NormType::kMax), 12);
+  EXPECT_DOUBLE_EQ(m.Norm(S21Matrix::NormType::kInf), 15);
+  EXPECT_DOUBLE_EQ(copy.Norm(), 5);
+  m.MulNumber(2);
+  EXPECT_DOUBLE_EQ(m.Norm(S21Matrix::NormType::kOne), 32);
+}
+
+TEST(CachedResults, EveryWriteChangesVersion) {
+  S21Matrix m(2, 2);
+  m(0, 0) = 1;
+  const unsigned long long first = m.GetVersion();
+  EXPECT_EQ(m.GetVersion(), first);
+  m(0, 0) = 2;
+  const unsigned long long second = m.GetVersion();
+  EXPECT_NE(second, first);
+  m(1, 1) += 1;
+  EXPECT_NE(m.GetVersion(), second);
+  const double value = m(1, 0);
+  EXPECT_EQ(value, 0);
+  const unsigned long long read = m.GetVersion();
+  EXPECT_EQ(m.GetVersion(), read);
+  swap(m(0, 0), m(1, 1));
+  EXPECT_NE(m.GetVersion(), read);
+  EXPECT_EQ(m(0, 0), 1);
+  EXPECT_EQ(m(1, 1), 2);
+}
+
+TEST(CachedResults, WriteThroughHeldCell) {
+  S21Matrix d(2, 2);
+  d(0, 0) = 2;
+  d(1, 1) = 3;
+  S21Matrix::CellRef q = d(1, 1);
+  const unsigned long long version = d.GetVersion();
+  EXPECT_EQ(d(0, 0), 2);
+  EXPECT_EQ(d.GetVersion(), version);
+  EXPECT_EQ(d.Determinant(), 6);
+  q = 5;
+  EXPECT_EQ(d.Determinant(), 10);
+  EXPECT_EQ(d.Determinant(), 10);
+  const S21Matrix copy(d);
+  q = 7;
+  EXPECT_EQ(copy.Determinant(), 10);
+  EXPECT_EQ(d.Determinant(), 14);
+}
+
+TEST(CachedResults, InverseInvalidatedByWrite) {
+  S21Matrix mat(2, 2);
+  mat(0, 0) = 2;
+  mat(1, 1) = 4;
+  S21Matrix first = mat.InverseMatrix();
+  EXPECT_EQ(first(0, 0), 0.5);
+  EXPECT_EQ(first(1, 1), 0.25);
+  mat(0, 0) = 8;
+  S21Matrix second = mat.InverseMatrix();
+  EXPECT_EQ(second(0, 0), 0.125);
+  EXPECT_EQ(second(1, 1), 0.25);
+}
+
+TEST(CachedResults, CopiesAndMovesKeepCacheConsistent) {
+  S21Matrix mat(2, 2);
+  mat(0, 0) = 1;
+  mat(1, 1) = 3;
+  EXPECT_EQ(mat.Determinant(), 3);
+  S21Matrix copy(mat);
+  EXPECT_EQ(copy.GetVersion(), mat.GetVersion());
+  copy(1, 1) = 5;
+  EXPECT_EQ(copy.Determinant(), 5);
+  EXPECT_EQ(mat.Determinant(), 3);
+  S21Matrix moved(std::move(copy));
+  EXPECT_EQ(moved.Determinant(), 5);
+  mat = moved;
+  EXPECT_EQ(mat.Determinant(), 5);
+  moved(0, 0) = 2;
+  mat = std::move(moved);
+  EXPECT_EQ(mat.Determinant(), 10);
+}
+
+/* ============================ Linear systems ============================ */
+
+// Sets the size of the thread pool for the scope and restores the previous
+// size on exit, also when an assertion fails or an exception is thrown
+class ThreadCountGuard {
+ public:
+  explicit ThreadCountGuard(int threads)
+      : saved_(S21ThreadPool::Instance().GetThreadCount()) {
+    S21ThreadPool::Instance().SetThreadCount(threads);
+  }
+  ~ThreadCountGuard() { S21ThreadPool::Instance().SetThreadCount(saved_); }
+  ThreadCountGuard(const ThreadCountGuard &) = delete;
+  ThreadCountGuard &operator=(const ThreadCountGuard &) = delete;
+
+ private:
+  int saved_;
+};
+
+// Fills the matrix with values that make it diagonally dominant
+static void FillDominant(S21Matrix &matrix) {
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      matrix(i, j) =
+          (i == j) ? matrix.GetRows() + 1.0 : ((i * 7 + j * 3) % 5) - 2;
+    }
+  }
+}
+
+TEST(LinearSystems, FactorizeReconstructsMatrix) {
+  S21Matrix matrix(5, 5);
+  FillDominant(matrix);
+  matrix(0, 0) = 0;
+  S21LU lu = matrix.Factorize();
+  S21Matrix product = lu.GetL() * lu.GetU();
+  const std::vector<int> &pivots = lu.GetPivots();
+  S21Matrix permuted(matrix);
+  for (int i = 0; i < 5; i++) {
+    for (int j = 0; j < 5; j++) {
+      swap(permuted(i, j), permuted(pivots[i], j));
+    }
+  }
+  EXPECT_TRUE(product == permuted);
+}
+
+TEST(LinearSystems, SolveMultipleRightHandSides) {
+  S21Matrix matrix(130, 130);
+  FillDominant(matrix);
+  S21Matrix expected(130, 70);
+  for (int i = 0; i < expected.GetRows(); i++) {
+    for (int j = 0; j < expected.GetCols(); j++) {
+      expected(i, j) = (i - j) % 9;
+    }
+  }
+  S21Matrix rhs = matrix * expected;
+  ThreadCountGuard threads(4);
+  S21Matrix solution = matrix.Solve(rhs);
+  EXPECT_TRUE(solution == expected);
+  EXPECT_TRUE(matrix.Factorize().Solve(rhs) == expected);
+}
+
+TEST(LinearSystems, DeterminantAndInverseUseLU) {
+  S21Matrix matrix(4, 4);
+  double values[4][4] = {
+      {2, 0, 0, 1}, {0, 3, 0, 0}, {0, 0, 4, 0}, {1, 0, 0, 2}};
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix(i, j) = values[i][j];
+    }
+  }
+  EXPECT_NEAR(matrix.Determinant(), 36, 1e-12);
+  S21Matrix identity(4, 4);
+  for (int i = 0; i < 4; i++) identity(i, i) = 1;
+  EXPECT_TRUE(matrix * matrix.InverseMatrix() == identity);
+}
+
+TEST(LinearSystems, SingularMatrix) {
+  S21Matrix matrix(4, 4);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix(i, j) = i + j;
+    }
+  }
+  EXPECT_TRUE(matrix.Factorize().IsSingular());
+  EXPECT_THROW(matrix.Solve(S21Matrix(4, 1)), std::logic_error);
+  EXPECT_THROW(matrix.Solve(S21Matrix(3, 1)), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(2, 3).Factorize(), std::logic_error);
+}
+
+// Fills the matrix with a symmetric positive-definite matrix
+static void FillSymmetricPositive(S21Matrix &matrix) {
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j <= i; j++) {
+      matrix(i, j) = matrix(j, i) =
+          (i == j) ? matrix.GetRows() + 1.0 : ((i + j) % 3) - 1;
+    }
+  }
+}
+
+TEST(Cholesky, FactorsReconstructMatrix) {
+  S21Matrix matrix(70, 70);
+  FillSymmetricPositive(matrix);
+  S21Cholesky llt = matrix.Cholesky();
+  ASSERT_TRUE(llt.IsPositiveDefinite());
+  S21Matrix lower = llt.GetL();
+  EXPECT_TRUE(lower * lower.Transpose() == matrix);
+  S21Cholesky ldlt = matrix.CholeskyLDLT();
+  ASSERT_TRUE(ldlt.IsPositiveDefinite());
+  lower = ldlt.GetL();
+  EXPECT_TRUE(lower * ldlt.GetD() * lower.Transpose() == matrix);
+}
+
+TEST(Cholesky, SolveInverseAndLogDeterminant) {
+  S21Matrix matrix(90, 90);
+  FillSymmetricPositive(matrix);
+  S21Matrix expected(90, 3);
+  for (int i = 0; i < expected.GetRows(); i++) {
+    for (int j = 0; j < expected.GetCols(); j++) {
+      expected(i, j) = (i * j) % 7;
+    }
+  }
+  S21Matrix rhs = matrix * expected;
+  {
+    ThreadCountGuard threads(3);
+    EXPECT_TRUE(matrix.Cholesky().Solve(rhs) == expected);
+    EXPECT_TRUE(matrix.CholeskyLDLT().Solve(rhs) == expected);
+  }
+  EXPECT_TRUE(matrix.Cholesky().Inverse() == matrix.InverseMatrix());
+  EXPECT_TRUE(matrix.CholeskyLDLT().Inverse() == matrix.InverseMatrix());
+  S21Matrix small(3, 3);
+  FillSymmetricPositive(small);
+  EXPECT_NEAR(small.Cholesky().LogDeterminant(), log(small.Determinant()),
+              1e-12);
+  EXPECT_NEAR(small.CholeskyLDLT().LogDeterminant(),
+              log(small.Determinant()), 1e-12);
+}
+
+TEST(Cholesky, DetectsNonPositiveDefinite) {
+  S21Matrix indefinite(2, 2);
+  indefinite(0, 0) = 1;
+  indefinite(0, 1) = indefinite(1, 0) = 2;
+  indefinite(1, 1) = 1;
+  EXPECT_FALSE(indefinite.Cholesky().IsPositiveDefinite());
+  EXPECT_THROW(indefinite.Cholesky().Solve(S21Matrix(2, 1)), std::logic_error);
+  S21Matrix asymmetric(2, 2);
+  asymmetric(0, 0) = asymmetric(1, 1) = 4;
+  asymmetric(0, 1) = 1;
+  EXPECT_FALSE(asymmetric.CholeskyLDLT().IsPositiveDefinite());
+  EXPECT_NO_THROW(asymmetric.Solve(S21Matrix(2, 1)));
+}
+
+// Fills the matrix with values of a full column rank tall matrix
+static void FillTall(S21Matrix &matrix) {
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (int j = 0; j < matrix.GetCols(); j++) {
+      matrix(i, j) = ((i * 5 + j * 11) % 13) - 6 + (i == j ? 20 : 0);
+    }
+  }
+}
+
+TEST(QR, FactorsReconstructMatrix) {
+  S21Matrix matrix(90, 40);
+  FillTall(matrix);
+  S21QR qr = matrix.QR();
+  S21Matrix q = qr.GetQ();
+  EXPECT_EQ(q.GetRows(), 90);
+  EXPECT_EQ(q.GetCols(), 40);
+  EXPECT_TRUE(q * qr.GetR() == matrix);
+  S21Matrix identity(40, 40);
+  for (int i = 0; i < 40; i++) identity(i, i) = 1;
+  EXPECT_TRUE(q.Transpose() * q == identity);
+  S21Matrix full = qr.GetQ(false);
+  EXPECT_EQ(full.GetCols(), 90);
+  S21Matrix applied(full);
+  qr.ApplyQTransposed(applied);
+  S21Matrix square_identity(90, 90);
+  for (int i = 0; i < 90; i++) square_identity(i, i) = 1;
+  EXPECT_TRUE(applied == square_identity);
+}
+
+TEST(QR, LeastSquaresMatchesNormalEquations) {
+  S21Matrix matrix(300, 7);
+  FillTall(matrix);
+  S21Matrix rhs(300, 2);
+  for (int i = 0; i < 300; i++) {
+    rhs(i, 0) = i % 17;
+    rhs(i, 1) = (i * i) % 5;
+  }
+  S21Matrix transposed = matrix.Transpose();
+  S21Matrix expected = (transposed * matrix).Solve(transposed * rhs);
+  EXPECT_TRUE(matrix.QR().Solve(rhs) == expected);
+  ThreadCountGuard threads(4);
+  EXPECT_TRUE(S21QR::SolveTallSkinny(matrix, rhs) == expected);
+}
+
+TEST(QR, InvalidInput) {
+  EXPECT_THROW(S21Matrix(2, 3).QR(), std::logic_error);
+  EXPECT_FALSE(S21Matrix(3, 2).QR().IsFullRank());
+  EXPECT_THROW(S21Matrix(3, 2).QR().Solve(S21Matrix(3, 1)), std::logic_error);
+  S21Matrix matrix(3, 2);
+  FillTall(matrix);
+  EXPECT_THROW(matrix.QR().Solve(S21Matrix(2, 1)), std::invalid_argument);
+}
+
+TEST(SymmetricEigen, DecompositionReconstructsMatrix) {
+  S21Matrix matrix(80, 80);
+  for (int i = 0; i < 80; i++) {
+    for (int j = 0; j <= i; j++) {
+      matrix(i, j) = matrix(j, i) = ((i * 3 + j * 5) % 11) - 5;
+    }
+  }
+  ThreadCountGuard threads(4);
+  S21SymmetricEigen eigen = matrix.EigenSymmetric();
+  const std::vector<double> &values = eigen.GetValues();
+  ASSERT_EQ(values.size(), 80u);
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+  S21Matrix vectors = eigen.GetVectors();
+  S21Matrix diagonal(80, 80);
+  for (int i = 0; i < 80; i++) diagonal(i, i) = values[i];
+  EXPECT_TRUE(vectors * diagonal * vectors.Transpose() == matrix);
+  S21Matrix identity(80, 80);
+  for (int i = 0; i < 80; i++) identity(i, i) = 1;
+  EXPECT_TRUE(vectors.Transpose() * vectors == identity);
+}
+
+TEST(SymmetricEigen, BlockedReductionOnThreads) {
+  const int n = 150;
+  S21Matrix matrix(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j <= i; j++) {
+      matrix(i, j) = matrix(j, i) = ((i * 7 + j * 3) % 13) / 6.0 - 1;
+    }
+  }
+  const S21SymmetricEigen serial = [&matrix] {
+    ThreadCountGuard one(1);
+    return S21SymmetricEigen(matrix);
+  }();
+  ThreadCountGuard threads(4);
+  const S21SymmetricEigen parallel(matrix);
+  EXPECT_EQ(parallel.GetValues(), serial.GetValues());
+  const S21Matrix vectors = parallel.GetVectors();
+  EXPECT_TRUE(vectors == serial.GetVectors());
+  S21Matrix scaled(vectors);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) scaled(i, j) *= parallel.GetValues()[j];
+  }
+  EXPECT_TRUE(scaled * vectors.Transpose() == matrix);
+  EXPECT_TRUE(vectors.Transpose() * vectors == S21Matrix::Identity(n));
+  double trace = 0;
+  for (double value : parallel.GetValues()) trace += value;
+  EXPECT_NEAR(trace, matrix.Trace(), 1e-10);
+}
+
+TEST(SymmetricEigen, ValuesOnlyAndSubset) {
+  S21Matrix matrix(4, 4);
+  double values[4][4] = {
+      {4, 1, 0, 0}, {1, 3, 1, 0}, {0, 1, 2, 1}, {0, 0, 1, 1}};
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 4; j++) {
+      matrix(i, j) = values[i][j];
+    }
+  }
+  S21SymmetricEigen eigen = matrix.EigenSymmetric(false);
+  EXPECT_FALSE(eigen.HasVectors());
+  EXPECT_THROW(eigen.GetVectors(), std::logic_error);
+  const std::vector<double> &all = eigen.GetValues();
+  EXPECT_NEAR(all[0] + all[1] + all[2] + all[3], 10, 1e-12);
+  EXPECT_NEAR(all[0] * all[1] * all[2] * all[3], matrix.Determinant(), 1e-10);
+  std::vector<double> subset = S21SymmetricEigen::Values(matrix, 1, 2);
+  ASSERT_EQ(subset.size(), 2u);
+  EXPECT_NEAR(subset[0], all[1], 1e-12);
+  EXPECT_NEAR(subset[1], all[2], 1e-12);
+  EXPECT_THROW(S21SymmetricEigen::Values(matrix, 2, 4), std::out_of_range);
+}
+
+TEST(SymmetricEigen, InvalidInput) {
+  EXPECT_THROW(S21Matrix(2, 3).EigenSymmetric(), std::logic_error);
+  S21Matrix asymmetric(2, 2);
+  asymmetric(0, 1) = 1;
+  EXPECT_THROW(asymmetric.EigenSymmetric(), std::logic_error);
+  S21Matrix single(1, 1);
+  single(0, 0) = 7;
+  EXPECT_EQ(single.EigenSymmetric().GetValues()[0], 7);
+}
+
+TEST(SVD, DecompositionReconstructsMatrix) {
+  S21Matrix tall(60, 35);
+  FillTall(tall);
+  ThreadCountGuard threads(4);
+  S21SVD svd = tall.SVD();
+  const std::vector<double> &values = svd.GetSingularValues();
+  ASSERT_EQ(values.size(), 35u);
+  EXPECT_TRUE(std::is_sorted(values.rbegin(), values.rend()));
+  EXPECT_TRUE(svd.Reconstruct() == tall);
+  S21Matrix identity(35, 35);
+  for (int i = 0; i < 35; i++) identity(i, i) = 1;
+  EXPECT_TRUE(svd.GetU().Transpose() * svd.GetU() == identity);
+  EXPECT_TRUE(svd.GetV().Transpose() * svd.GetV() == identity);
+  S21Matrix wide = tall.Transpose();
+  S21SVD wide_svd = wide.SVD();
+  EXPECT_EQ(wide_svd.GetU().GetRows(), 35);
+  EXPECT_EQ(wide_svd.GetV().GetRows(), 60);
+  EXPECT_TRUE(wide_svd.Reconstruct() == wide);
+  EXPECT_NEAR(wide_svd.GetSingularValues()[0], values[0], 1e-9);
+}
+
+TEST(SVD, RankAndPseudoInverseOfSingularMatrix) {
+  S21Matrix matrix(4, 3);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 3; j++) {
+      matrix(i, j) = (i + 1) * (j + 1) + (j == 2 ? i : 0);
+    }
+  }
+  S21SVD svd = matrix.SVD();
+  EXPECT_EQ(svd.Rank(), 2);
+  S21Matrix pseudo = svd.PseudoInverse();
+  EXPECT_EQ(pseudo.GetRows(), 3);
+  EXPECT_TRUE(matrix * pseudo * matrix == matrix);
+  EXPECT_TRUE(pseudo * matrix * pseudo == pseudo);
+  S21Matrix square(3, 3);
+  for (int i = 0; i < 3; i++) square(i, 0) = 1;
+  EXPECT_THROW(square.InverseMatrix(), std::logic_error);
+  EXPECT_EQ(square.SVD().Rank(), 1);
+}
+
+TEST(SVD, TruncatedFindsLowRankStructure) {
+  S21Matrix left(200, 3), right(3, 150);
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < 3; j++) left(i, j) = ((i * (j + 2)) % 7) - 3;
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 150; j++) right(i, j) = ((j * (i + 5)) % 11) - 5;
+  }
+  S21Matrix matrix = left * right;
+  S21SVD truncated = S21SVD::Truncated(matrix, 3);
+  ASSERT_EQ(truncated.GetSingularValues().size(), 3u);
+  EXPECT_EQ(truncated.GetU().GetCols(), 3);
+  EXPECT_EQ(truncated.GetV().GetRows(), 150);
+  EXPECT_TRUE(truncated.Reconstruct() == matrix);
+  std::vector<double> exact = matrix.SVD().GetSingularValues();
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(truncated.GetSingularValues()[i], exact[i], 1e-8 * exact[0]);
+  }
+  EXPECT_THROW(S21SVD::Truncated(matrix, 0), std::invalid_argument);
+}
+
+/* ============================ Product kernel ============================ */
+
+// Returns the row pointers of a row-major buffer with the given row length
+static std::vector<double *> RowsOf(std::vector<double> &buffer, int cols) {
+  std::vector<double *> rows;
+  for (size_t i = 0; i < buffer.size(); i += cols) {
+    rows.push_back(buffer.data() + i);
+  }
+  return rows;
+}
+
+TEST(Gemm, MulMatrixMatchesNaiveProduct) {
+  // Sizes cross the row, depth and column blocks of the kernel unevenly
+  const int sizes[][3] = {{1, 1, 1}, {3, 1, 5}, {7, 130, 3}, {263, 301, 259}};
+  ThreadCountGuard threads(4);
+  for (const auto &size : sizes) {
+    const int m = size[0], k = size[1], n = size[2];
+    S21Matrix a(m, k), b(k, n);
+    for (int i = 0; i < m; i++) {
+      for (int p = 0; p < k; p++) a(i, p) = (i * 7 + p * 3) % 11 - 5;
+    }
+    for (int p = 0; p < k; p++) {
+      for (int j = 0; j < n; j++) b(p, j) = (p * 5 + j * 2) % 13 - 6;
+    }
+    S21Matrix product(a);
+    product.MulMatrix(b);
+    ASSERT_EQ(product.GetRows(), m);
+    ASSERT_EQ(product.GetCols(), n);
+    for (int i = 0; i < m; i++) {
+      for (int j = 0; j < n; j++) {
+        double sum = 0;
+        for (int p = 0; p < k; p++) sum += a(i, p) * b(p, j);
+        ASSERT_EQ(product(i, j), sum) << m << "x" << k << "x" << n;
+      }
+    }
+  }
+}
+
+TEST(Gemm, AccumulatesScaledAndTransposedProducts) {
+  const int m = 70, n = 90, k = 150;
+  std::vector<double> a(m * k), b(k * n), at(k * m), bt(n * k);
+  for (int i = 0; i < m; i++) {
+    for (int p = 0; p < k; p++) {
+      a[i * k + p] = at[p * m + i] = (i * 3 + p) % 7 - 3;
+    }
+  }
+  for (int p = 0; p < k; p++) {
+    for (int j = 0; j < n; j++) {
+      b[p * n + j] = bt[j * k + p] = (p + j * 5) % 9 - 4;
+    }
+  }
+  std::vector<double> plain(m * n, 1.0), left(plain), right(plain);
+  ThreadCountGuard threads(4);
+  S21Gemm(m, n, k, RowsOf(a, k).data(), RowsOf(b, n).data(),
+          RowsOf(plain, n).data(), -2.0);
+  S21GemmTN(m, n, k, RowsOf(at, m).data(), RowsOf(b, n).data(),
+            RowsOf(left, n).data(), -2.0);
+  S21GemmNT(m, n, k, RowsOf(a, k).data(), RowsOf(bt, k).data(),
+            RowsOf(right, n).data(), -2.0);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      double sum = 0;
+      for (int p = 0; p < k; p++) sum += a[i * k + p] * b[p * n + j];
+      EXPECT_EQ(plain[i * n + j], 1.0 - 2.0 * sum);
+      EXPECT_EQ(left[i * n + j], 1.0 - 2.0 * sum);
+      EXPECT_EQ(right[i * n + j], 1.0 - 2.0 * sum);
+    }
+  }
+  const std::vector<double> before(plain);
+  S21Gemm(m, n, 0, RowsOf(a, k).data(), RowsOf(b, n).data(),
+          RowsOf(plain, n).data());
+  EXPECT_EQ(plain, before);
+}
+
+TEST(Gemm, OperatorsOnConstOperands) {
+  S21Matrix filled(2, 2);
+  filled(0, 0) = 1;
+  filled(0, 1) = 2;
+  filled(1, 0) = 3;
+  filled(1, 1) = 4;
+  const S21Matrix a(filled);
+  const S21Matrix b = a.Transpose();
+  const S21Matrix product = a * b;
+  EXPECT_EQ(product(0, 0), 5);
+  EXPECT_EQ(product(0, 1), 11);
+  EXPECT_EQ(product(1, 1), 25);
+  EXPECT_TRUE(a + b - b == a);
+  EXPECT_EQ((a * 2.0)(1, 0), 6);
+  EXPECT_EQ((a - b)(0, 1), -1);
+}
+
+/* =============================== Vectors ================================ */
+
+TEST(Vector, ConstructorsAndAccess) {
+  EXPECT_THROW(S21Vector(0), std::invalid_argument);
+  S21Vector vector(3);
+  EXPECT_EQ(vector.GetSize(), 3);
+  EXPECT_EQ(vector(2), 0);
+  EXPECT_THROW(vector(3), std::out_of_range);
+  EXPECT_THROW(vector(-1), std::out_of_range);
+  vector(1) = 5;
+  S21Vector copy(vector);
+  S21Vector moved(std::move(copy));
+  EXPECT_TRUE(moved == vector);
+  EXPECT_EQ(copy.GetSize(), 0);
+  S21Matrix column = vector.ToMatrix();
+  EXPECT_EQ(column(1, 0), 5);
+  EXPECT_TRUE(S21Vector(column) == vector);
+  EXPECT_THROW(S21Vector(S21Matrix(2, 2)), std::invalid_argument);
+}
+
+TEST(Vector, LevelOneOperations) {
+  S21Vector x(5), y(5);
+  for (int i = 0; i < 5; i++) {
+    x(i) = i + 1;
+    y(i) = 2 - i;
+  }
+  EXPECT_EQ(x.Dot(y), 2 + 2 + 0 - 4 - 10);
+  x.Axpy(2, y);
+  EXPECT_EQ(x(0), 5);
+  EXPECT_EQ(x(4), 1);
+  S21Vector z(2);
+  z(0) = 3e200;
+  z(1) = 4e200;
+  EXPECT_NEAR(z.Norm(), 5e200, 1e186);
+  EXPECT_THROW(x.Dot(z), std::invalid_argument);
+}
+
+TEST(Vector, MatrixVectorKernels) {
+  S21Matrix matrix(300, 200);
+  FillTall(matrix);
+  S21Vector x(200), y(300);
+  for (int i = 0; i < 200; i++) x(i) = (i % 5) - 2;
+  for (int i = 0; i < 300; i++) y(i) = (i % 3) - 1;
+  ThreadCountGuard threads(4);
+  S21Vector product = matrix.MulVector(x);
+  S21Vector transposed = matrix.MulVectorTransposed(y);
+  S21Matrix updated(matrix);
+  updated.RankOneUpdate(0.5, y, x);
+  EXPECT_TRUE(product.ToMatrix() == matrix * x.ToMatrix());
+  EXPECT_TRUE(transposed.ToMatrix() == matrix.Transpose() * y.ToMatrix());
+  EXPECT_TRUE(updated ==
+              matrix + y.ToMatrix() * x.ToMatrix().Transpose() * 0.5);
+  EXPECT_THROW(matrix.MulVector(y), std::invalid_argument);
+  EXPECT_THROW(matrix.MulVectorTransposed(x), std::invalid_argument);
+}
+
+TEST(MixedPrecision, RefinesToDoubleAccuracy) {
+  S21Matrix matrix(150, 150);
+  FillDominant(matrix);
+  matrix(3, 7) = 0.1234567890123;
+  S21Matrix expected(150, 2);
+  for (int i = 0; i < 150; i++) {
+    expected(i, 0) = 1.0 / (i + 1);
+    expected(i, 1) = sqrt(i + 2.0);
+  }
+  S21Matrix rhs = matrix * expected;
+  S21MixedLU mixed(matrix);
+  S21MixedLU::SolveReport report;
+  S21Matrix solution = mixed.Solve(rhs, &report);
+  EXPECT_FALSE(report.used_double);
+  EXPECT_GT(report.iterations, 0);
+  EXPECT_LT(mixed.GetConditionEstimate(), 100);
+  for (int i = 0; i < 150; i++) {
+    EXPECT_NEAR(solution(i, 0), expected(i, 0), 1e-13);
+    EXPECT_NEAR(solution(i, 1), expected(i, 1), 1e-13);
+  }
+  EXPECT_TRUE(matrix.SolveMixed(rhs) == expected);
+}
+
+TEST(MixedPrecision, FallsBackForIllConditionedMatrix) {
+  S21Matrix hilbert(9, 9);
+  for (int i = 0; i < 9; i++) {
+    for (int j = 0; j < 9; j++) {
+      hilbert(i, j) = 1.0 / (i + j + 1);
+    }
+  }
+  S21Matrix rhs(9, 1);
+  for (int i = 0; i < 9; i++) rhs(i, 0) = 1;
+  S21MixedLU mixed(hilbert);
+  EXPECT_GT(mixed.GetConditionEstimate(), 1e7);
+  S21MixedLU::SolveReport report;
+  S21Matrix solution = mixed.Solve(rhs, &report);
+  EXPECT_TRUE(report.used_double);
+  EXPECT_TRUE(solution == hilbert.Solve(rhs));
+  EXPECT_THROW(mixed.Solve(S21Matrix(3, 1)), std::invalid_argument);
+  EXPECT_THROW(S21MixedLU(S21Matrix(2, 3)), std::logic_error);
+}
+
+TEST(MixedPrecision, ConcurrentSolves) {
+  S21Matrix matrix(120, 120), hilbert(8, 8);
+  FillDominant(matrix);
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 8; j++) hilbert(i, j) = 1.0 / (i + j + 1);
+  }
+  const S21Matrix copy(matrix), hilbert_copy(hilbert);
+  matrix.SolveMixed(S21Matrix(120, 1));
+  const S21MixedLU fallback(hilbert);
+  std::atomic<int> failures{0};
+  ThreadCountGuard threads(4);
+  S21ThreadPool::Instance().ParallelFor(0, 16, 1, [&](int begin, int end) {
+    for (int k = begin; k < end; k++) {
+      S21Matrix rhs(120, 1), small(8, 1);
+      rhs(k, 0) = 1;
+      small(k % 8, 0) = 1;
+      const S21Matrix &source = k % 2 ? matrix : copy;
+      if (!(source * source.SolveMixed(rhs) == rhs)) failures++;
+      S21MixedLU::SolveReport report;
+      const S21Matrix x = fallback.Solve(small, &report);
+      if (!report.used_double || !(x == hilbert_copy.Solve(small))) failures++;
+    }
+  });
+  EXPECT_EQ(failures, 0);
+}
+
+TEST(Graph, MatchesEagerEvaluation) {
+  ThreadCountGuard threads(4);
+  S21Matrix a(40, 40), b(40, 40);
+  FillDominant(a);
+  FillDominant(b);
+  b(1, 2) = -3;
+  S21Graph graph;
+  const int x = graph.Input(a), y = graph.Input(b);
+  const int product = graph.Mul(x, y);
+  const int left = graph.Sum(product, graph.MulNumber(x, 2));
+  const int right = graph.Sub(graph.Transpose(y), graph.Inverse(x));
+  const int result = graph.Mul(left, right);
+  graph.Mul(graph.Inverse(y), x);
+  std::vector<S21Matrix> values = graph.Evaluate({result, left});
+  S21Matrix expected_left = a * b + a * 2;
+  S21Matrix expected = expected_left * (b.Transpose() - a.InverseMatrix());
+  EXPECT_TRUE(values[0] == expected);
+  EXPECT_TRUE(values[1] == expected_left);
+  EXPECT_EQ(graph.GetLastExecutedCount(), 7);
+  EXPECT_LE(graph.GetLastPeakLive(), 5);
+}
+
+TEST(Graph, EliminatesCommonSubexpressions) {
+  S21Matrix a(3, 2), b(2, 3);
+  a(0, 0) = 1;
+  a(2, 1) = 4;
+  b(1, 2) = 5;
+  S21Graph graph;
+  const int x = graph.Input(a), y = graph.Input(b);
+  EXPECT_EQ(graph.Input(a), x);
+  const int product = graph.Mul(x, y);
+  EXPECT_EQ(graph.Mul(x, y), product);
+  const int doubled = graph.Sum(product, product);
+  EXPECT_EQ(graph.Sum(product, product), doubled);
+  EXPECT_EQ(graph.Transpose(graph.Transpose(x)), x);
+  EXPECT_EQ(graph.MulNumber(x, 1), x);
+  EXPECT_EQ(graph.GetNodeCount(), 5);
+  EXPECT_EQ(graph.GetReusedCount(), 4);
+  EXPECT_EQ(graph.GetRows(doubled), 3);
+  EXPECT_EQ(graph.GetCols(doubled), 3);
+  EXPECT_TRUE(graph.Evaluate(doubled) == a * b * 2);
+  EXPECT_TRUE(graph.Evaluate(x) == a);
+}
+
+TEST(Graph, InputChangedBetweenCalls) {
+  S21Matrix m(2, 2);
+  m(0, 0) = 1;
+  S21Graph graph;
+  const int a = graph.Input(m);
+  m(0, 0) = 5;
+  const int b = graph.Input(m);
+  EXPECT_NE(a, b);
+  S21Matrix::CellRef cell = m(1, 1);
+  EXPECT_EQ(graph.Input(m), b);
+  cell = 2;
+  const int c = graph.Input(m);
+  EXPECT_NE(c, b);
+  EXPECT_DOUBLE_EQ(graph.Evaluate(graph.Sum(b, b))(0, 0), 10);
+  EXPECT_DOUBLE_EQ(graph.Evaluate(a)(0, 0), 1);
+  EXPECT_DOUBLE_EQ(graph.Evaluate(c)(1, 1), 2);
+}
+
+TEST(Graph, WaitingThreadsRunQueuedTasks) {
+  ThreadCountGuard threads(2);
+  S21ThreadPool &pool = S21ThreadPool::Instance();
+  std::atomic<int> waiting_done{0};
+  std::atomic<bool> last_done{false};
+  // Both threads end up waiting for the last task, which only runs because a
+  // waiting thread picks it up
+  for (int i = 0; i < 2; i++) {
+    pool.Post([&pool, &waiting_done, &last_done] {
+      pool.HelpUntil([&last_done] { return last_done.load(); });
+      waiting_done++;
+      pool.Wake();
+    });
+  }
+  pool.Post([&pool, &last_done] {
+    last_done = true;
+    pool.Wake();
+  });
+  pool.HelpUntil([&waiting_done] { return waiting_done == 2; });
+  EXPECT_TRUE(last_done);
+}
+
+TEST(Graph, ChainWithParallelOperations) {
+  ThreadCountGuard threads(4);
+  S21Matrix a(150, 150), b(150, 150);
+  FillDominant(a);
+  FillDominant(b);
+  b(3, 4) = 7;
+  S21Graph graph;
+  const int x = graph.Input(a), y = graph.Input(b);
+  int node = graph.Mul(x, y);
+  S21Matrix expected = a * b;
+  for (int step = 0; step < 4; step++) {
+    node = graph.Sub(graph.Mul(node, x), graph.MulNumber(y, step + 2));
+    expected = expected * a - b * (step + 2);
+  }
+  EXPECT_TRUE(graph.Evaluate(node) == expected);
+}
+
+TEST(Graph, ReportsErrors) {
+  S21Matrix a(2, 3), singular(2, 2);
+  S21Graph graph;
+  const int x = graph.Input(a), y = graph.Input(singular);
+  EXPECT_THROW(graph.Sum(x, y), std::invalid_argument);
+  EXPECT_THROW(graph.Mul(x, y), std::invalid_argument);
+  EXPECT_THROW(graph.Inverse(x), std::logic_error);
+  EXPECT_THROW(graph.Transpose(5), std::out_of_range);
+  const int inverse = graph.Sum(graph.Inverse(y), y);
+  EXPECT_THROW(graph.Evaluate(inverse), std::logic_error);
+}
+
+TEST(Async, MatchesSynchronousResults) {
+  ThreadCountGuard threads(4);
+  S21Matrix a(300, 200), b(200, 150), square(260, 260), small(60, 60);
+  FillTall(a);
+  FillTall(b);
+  FillDominant(square);
+  FillDominant(small);
+  std::vector<double> steps;
+  std::future<S21Matrix> product = a.MulMatrixAsync(
+      b, {}, [&steps](double done) { steps.push_back(done); });
+  std::future<S21Matrix> inverse = square.InverseAsync();
+  std::future<double> determinant = small.DeterminantAsync();
+  EXPECT_TRUE(product.get() == a * b);
+  EXPECT_TRUE(inverse.get() == square.InverseMatrix());
+  EXPECT_NEAR(determinant.get(), small.Determinant(),
+              1e-9 * fabs(small.Determinant()));
+  ASSERT_EQ(steps.size(), 3U);
+  EXPECT_TRUE(std::is_sorted(steps.begin(), steps.end()));
+  EXPECT_DOUBLE_EQ(steps.back(), 1);
+}
+
+TEST(Async, Cancellation) {
+  S21Matrix a(400, 400);
+  FillDominant(a);
+  S21CancellationToken cancelled;
+  cancelled.Cancel();
+  EXPECT_THROW(a.MulMatrixAsync(a, cancelled).get(), S21OperationCancelled);
+  EXPECT_THROW(a.DeterminantAsync(cancelled).get(), S21OperationCancelled);
+  S21CancellationToken token;
+  double last = 0;
+  std::future<S21Matrix> inverse =
+      a.InverseAsync(token, [&token, &last](double done) {
+        last = done;
+        if (done > 0.5) token.Cancel();
+      });
+  EXPECT_THROW(inverse.get(), S21OperationCancelled);
+  EXPECT_TRUE(token.IsCancelled());
+  EXPECT_LT(last, 1);
+  EXPECT_THROW(a.MulMatrixAsync(S21Matrix(3, 3)), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(2, 3).InverseAsync(), std::logic_error);
+  EXPECT_THROW(S21Matrix(5, 5).InverseAsync().get(), std::logic_error);
+}
+
+TEST(TransposedView, Products) {
+  ThreadCountGuard threads(4);
+  S21Matrix a(130, 70), b(130, 90), c(70, 90);
+  FillTall(a);
+  FillTall(b);
+  FillTall(c);
+  c(5, 3) = 0.5;
+  EXPECT_TRUE(a.T() * b == a.Transpose() * b);
+  EXPECT_TRUE(b * c.T() == b * c.Transpose());
+  EXPECT_TRUE(c.T() * a.T() == c.Transpose() * a.Transpose());
+  S21Matrix product(b);
+  product.MulMatrix(c.T());
+  EXPECT_TRUE(product == b * c.Transpose());
+  EXPECT_EQ(a.T().GetRows(), 70);
+  EXPECT_EQ(a.T().GetCols(), 130);
+  EXPECT_DOUBLE_EQ(c.T()(3, 5), 0.5);
+  EXPECT_TRUE(a.T().Materialize() == a.Transpose());
+  EXPECT_THROW(a.T() * c, std::invalid_argument);
+  EXPECT_THROW(a * b.T(), std::invalid_argument);
+}
+
+TEST(TransposedView, SumsAndVectors) {
+  S21Matrix a(50, 40), b(40, 50), square(45, 45);
+  FillTall(a);
+  FillTall(b);
+  FillDominant(square);
+  square(0, 44) = 7;
+  EXPECT_TRUE(a + b.T() == a + b.Transpose());
+  EXPECT_TRUE(a - b.T() == a - b.Transpose());
+  EXPECT_TRUE(b.T() + a == a + b.Transpose());
+  S21Matrix symmetric_part = square + square.Transpose();
+  square.SumMatrix(square.T());
+  EXPECT_TRUE(square == symmetric_part);
+  S21Vector x(50);
+  for (int i = 0; i < 50; i++) x(i) = i % 7 - 3;
+  EXPECT_TRUE(a.T().MulVector(x) == a.Transpose().MulVector(x));
+  EXPECT_THROW(a.SumMatrix(a.T()), std::invalid_argument);
+}
+
+TEST(MatrixFunctions, Pow) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 1;
+  a(0, 1) = 2;
+  a(1, 1) = -1;
+  a(1, 2) = 3;
+  a(2, 0) = 2;
+  a(2, 2) = 1;
+  EXPECT_TRUE(a.Pow(5) == a * a * a * a * a);
+  EXPECT_TRUE(a.Pow(1) == a);
+  EXPECT_TRUE(a.Pow(0) == S21Matrix::Identity(3));
+  EXPECT_TRUE(a.Pow(-2) == a.InverseMatrix() * a.InverseMatrix());
+  S21Matrix chain(80, 80);
+  for (int i = 0; i < 80; i++) {
+    chain(i, i) = 0.5;
+    chain(i, (i * 7 + 1) % 80) += 0.3;
+    chain(i, (i + 5) % 80) += 0.2;
+  }
+  S21Matrix expected = S21Matrix::Identity(80);
+  for (int i = 0; i < 37; i++) expected *= chain;
+  S21Matrix power = chain.Pow(37);
+  EXPECT_TRUE(power == expected);
+  EXPECT_THROW(S21Matrix(2, 3).Pow(2), std::logic_error);
+}
+
+TEST(MatrixFunctions, PowEveryBitPattern) {
+  S21Matrix a(4, 4);
+  FillDominant(a);
+  a.MulNumber(0.2);
+  S21Matrix expected = S21Matrix::Identity(4);
+  for (int power = 1; power <= 13; power++) {
+    expected *= a;
+    EXPECT_TRUE(a.Pow(power) == expected);
+  }
+  const S21Matrix inverse = a.InverseMatrix();
+  EXPECT_TRUE(a.Pow(-3) == inverse * inverse * inverse);
+}
+
+TEST(MatrixFunctions, EmptyMatrix) {
+  const S21Matrix empty;
+  EXPECT_EQ(S21Matrix::Identity(0).GetRows(), 0);
+  EXPECT_EQ(S21Matrix::Identity(0).GetCols(), 0);
+  for (int power : {-2, 0, 1, 5}) {
+    EXPECT_EQ(empty.Pow(power).GetRows(), 0);
+  }
+  EXPECT_EQ(empty.Expm().GetRows(), 0);
+  EXPECT_THROW(S21Matrix::Identity(-1), std::invalid_argument);
+}
+
+TEST(MatrixFunctions, Expm) {
+  S21Matrix diagonal(2, 2);
+  diagonal(0, 0) = 1;
+  diagonal(1, 1) = -2;
+  S21Matrix exponential = diagonal.Expm();
+  EXPECT_NEAR(exponential(0, 0), exp(1), 1e-14);
+  EXPECT_NEAR(exponential(1, 1), exp(-2), 1e-15);
+  EXPECT_NEAR(exponential(0, 1), 0, 1e-15);
+  S21Matrix nilpotent(2, 2);
+  nilpotent(0, 1) = 0.01;
+  exponential = nilpotent.Expm();
+  EXPECT_DOUBLE_EQ(exponential(0, 0), 1);
+  EXPECT_DOUBLE_EQ(exponential(0, 1), 0.01);
+  EXPECT_TRUE(S21Matrix(4, 4).Expm() == S21Matrix::Identity(4));
+  S21Matrix rotation(2, 2);
+  rotation(0, 1) = -30;
+  rotation(1, 0) = 30;
+  exponential = rotation.Expm();
+  EXPECT_NEAR(exponential(0, 0), cos(30), 1e-12);
+  EXPECT_NEAR(exponential(1, 0), sin(30), 1e-12);
+  S21Matrix a(60, 60);
+  FillTall(a);
+  a.MulNumber(0.05);
+  S21Matrix product = a.Expm() * (a * -1).Expm();
+  EXPECT_TRUE(product == S21Matrix::Identity(60));
+  EXPECT_THROW(S21Matrix(2, 3).Expm(), std::logic_error);
+}
+
+TEST(MatrixFunctions, ExpmOfNonFiniteMatrix) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 1;
+  a(1, 2) = std::numeric_limits<double>::infinity();
+  S21Matrix exponential = a.Expm();
+  ASSERT_EQ(exponential.GetRows(), 3);
+  EXPECT_TRUE(std::isnan(exponential(0, 0)));
+  EXPECT_TRUE(std::isnan(exponential(2, 1)));
+  a(1, 2) = std::numeric_limits<double>::quiet_NaN();
+  exponential = a.Expm();
+  EXPECT_TRUE(std::isnan(exponential(1, 1)));
+}
+
+TEST(Assembly, StacksAndBlocks) {
+  S21Matrix a(2, 2), b(2, 3), c(1, 4), d(1, 1);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 2; j++) a(i, j) = i * 2 + j;
+    for (int j = 0; j < 3; j++) b(i, j) = 10 + i * 3 + j;
+  }
+  for (int j = 0; j < 4; j++) c(0, j) = 20 + j;
+  d(0, 0) = 30;
+  S21Matrix wide = S21Matrix::HStack({a, b});
+  ASSERT_EQ(wide.GetRows(), 2);
+  ASSERT_EQ(wide.GetCols(), 5);
+  EXPECT_DOUBLE_EQ(wide(1, 1), 3);
+  EXPECT_DOUBLE_EQ(wide(1, 2), 13);
+  EXPECT_DOUBLE_EQ(wide(0, 4), 12);
+  S21Matrix tall = S21Matrix::VStack({wide, S21Matrix::HStack({c, d})});
+  S21Matrix block = S21Matrix::Block({{a, b}, {c, d}});
+  EXPECT_TRUE(tall == block);
+  ASSERT_EQ(block.GetRows(), 3);
+  EXPECT_DOUBLE_EQ(block(2, 3), 23);
+  EXPECT_DOUBLE_EQ(block(2, 4), 30);
+  EXPECT_THROW(S21Matrix::HStack({a, c}), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::VStack({a, b}), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Block({{a, b}, {c}}), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::Block({{a}, {}}), std::invalid_argument);
+}
+
+TEST(Assembly, EmptyBlocks) {
+  const S21Matrix empty, a(2, 3);
+  S21Matrix grid = S21Matrix::Block({{empty, empty}, {empty}});
+  EXPECT_EQ(grid.GetRows(), 0);
+  EXPECT_EQ(grid.GetCols(), 0);
+  EXPECT_EQ(S21Matrix::Block({}).GetRows(), 0);
+  EXPECT_EQ(S21Matrix::HStack({}).GetRows(), 0);
+  EXPECT_EQ(S21Matrix::VStack({empty, empty}).GetRows(), 0);
+  EXPECT_THROW(S21Matrix::Block({{a}, {empty}}), std::invalid_argument);
+}
+
+TEST(Assembly, Kronecker) {
+  S21Matrix a(2, 2), b(2, 3);
+  a(0, 0) = 1;
+  a(0, 1) = 2;
+  a(1, 0) = 3;
+  a(1, 1) = 4;
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) b(i, j) = i - j;
+  }
+  S21Matrix product = a.Kronecker(b);
+  ASSERT_EQ(product.GetRows(), 4);
+  ASSERT_EQ(product.GetCols(), 6);
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 6; j++) {
+      EXPECT_DOUBLE_EQ(product(i, j), a(i / 2, j / 3) * b(i % 2, j % 3));
+    }
+  }
+  ThreadCountGuard threads(4);
+  S21Matrix x(40, 30), y(9, 11);
+  FillTall(x);
+  FillTall(y);
+  S21Matrix large = x.Kronecker(y);
+  EXPECT_DOUBLE_EQ(large(9 * 17 + 4, 11 * 23 + 6), x(17, 23) * y(4, 6));
+  // (A x B)(C x D) = AC x BD
+  EXPECT_TRUE(a.Kronecker(b) * a.Kronecker(b.Transpose()) ==
+              (a * a).Kronecker(b * b.Transpose()));
+}
+
+TEST(Band, StorageAndProducts) {
+  S21BandMatrix band(6, 1, 2);
+  band(0, 2) = 3;
+  band(4, 3) = -1;
+  band(5, 5) = 2;
+  EXPECT_THROW(band(3, 1), std::out_of_range);
+  EXPECT_THROW(band(6, 6), std::out_of_range);
+  const S21BandMatrix &view = band;
+  EXPECT_DOUBLE_EQ(view(3, 0), 0);
+  EXPECT_DOUBLE_EQ(view(0, 2), 3);
+  S21Matrix dense = band.ToMatrix();
+  EXPECT_DOUBLE_EQ(dense(4, 3), -1);
+  S21Matrix wide(50, 50);
+  FillTall(wide);
+  S21BandMatrix part(wide, 3, 2);
+  S21Matrix expected = part.ToMatrix();
+  EXPECT_DOUBLE_EQ(expected(10, 7), wide(10, 7));
+  EXPECT_DOUBLE_EQ(expected(10, 6), 0);
+  S21Vector x(50);
+  for (int i = 0; i < 50; i++) x(i) = sin(i);
+  EXPECT_TRUE(part.MulVector(x) == expected.MulVector(x));
+  EXPECT_THROW(S21BandMatrix(5, -1, 0), std::invalid_argument);
+}
+
+TEST(Band, Factorizations) {
+  const int n = 200;
+  S21BandMatrix general(n, 3, 2), symmetric(n, 4, 4);
+  for (int i = 0; i < n; i++) {
+    for (int j = std::max(0, i - 3); j <= std::min(n - 1, i + 2); j++) {
+      general(i, j) = ((i * 7 + j * 3) % 11) - 5;
+    }
+    for (int j = std::max(0, i - 4); j <= i; j++) {
+      const double value = i == j ? 10 : 1.0 / (1 + i - j + (i % 3));
+      symmetric(i, j) = value;
+      symmetric(j, i) = value;
+    }
+  }
+  S21Vector rhs(n);
+  for (int i = 0; i < n; i++) rhs(i) = cos(i);
+  S21BandLU lu(general);
+  ASSERT_FALSE(lu.IsSingular());
+  S21Vector solution = lu.Solve(rhs);
+  S21Matrix dense = general.ToMatrix();
+  EXPECT_TRUE(dense.MulVector(solution) == rhs);
+  EXPECT_TRUE(solution.ToMatrix() == dense.Solve(rhs.ToMatrix()));
+  EXPECT_NEAR(lu.LogAbsDeterminant(), log(fabs(dense.Determinant())), 1e-9);
+  S21BandCholesky cholesky(symmetric);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  EXPECT_TRUE(symmetric.MulVector(cholesky.Solve(rhs)) == rhs);
+  EXPECT_NEAR(cholesky.LogDeterminant(),
+              symmetric.ToMatrix().Cholesky().LogDeterminant(), 1e-9);
+  symmetric(5, 5) = -1;
+  EXPECT_FALSE(S21BandCholesky(symmetric).IsPositiveDefinite());
+  EXPECT_THROW(S21BandCholesky(symmetric).Solve(rhs), std::logic_error);
+  EXPECT_THROW(lu.Solve(S21Vector(3)), std::invalid_argument);
+  EXPECT_TRUE(S21BandLU(S21BandMatrix(4, 1, 1)).IsSingular());
+}
+
+TEST(Band, Tridiagonal) {
+  const int n = 100003;
+  S21BandMatrix matrix(n, 1, 1);
+  S21Vector rhs(n);
+  for (int i = 0; i < n; i++) {
+    if (i > 0) matrix(i, i - 1) = -1;
+    if (i + 1 < n) matrix(i, i + 1) = -1.5;
+    matrix(i, i) = 4 + (i % 5);
+    rhs(i) = (i % 17) - 8;
+  }
+  S21Vector thomas = matrix.SolveTridiagonal(rhs);
+  EXPECT_TRUE(matrix.MulVector(thomas) == rhs);
+  ThreadCountGuard threads(4);
+  S21Vector reduction = matrix.SolveTridiagonalParallel(rhs);
+  EXPECT_TRUE(reduction == thomas);
+  EXPECT_TRUE(S21BandLU(matrix).Solve(rhs) == thomas);
+  for (int size = 1; size < 12; size++) {
+    S21BandMatrix small(size, 1, 1);
+    S21Vector right(size);
+    for (int i = 0; i < size; i++) {
+      small(i, i) = 3;
+      if (i > 0) small(i, i - 1) = 1;
+      if (i + 1 < size) small(i, i + 1) = 1;
+      right(i) = i + 1;
+    }
+    EXPECT_TRUE(small.SolveTridiagonalParallel(right) ==
+                small.SolveTridiagonal(right));
+  }
+  EXPECT_THROW(S21BandMatrix(5, 2, 1).SolveTridiagonal(S21Vector(5)),
+               std::logic_error);
+}
+
+TEST(Triangular, SolveAndMultiply) {
+  const int size = 150, count = 7;
+  S21Matrix dense(size, size), rhs(size, count);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      dense(i, j) = i == j ? size + i : ((i * 7 + j * 3) % 11) / 10.0 - 0.5;
+    }
+    for (int j = 0; j < count; j++) {
+      rhs(i, j) = ((i + 1) * (j + 2)) % 13 - 6;
+    }
+  }
+  for (auto uplo : {S21TriangularMatrix::Uplo::kLower,
+                    S21TriangularMatrix::Uplo::kUpper}) {
+    S21TriangularMatrix triangle(dense, uplo);
+    S21Matrix full = triangle.ToMatrix();
+    EXPECT_TRUE(triangle.Multiply(rhs) == full * rhs);
+    S21Matrix solution = triangle.Solve(rhs);
+    EXPECT_TRUE(full * solution == rhs);
+    EXPECT_TRUE(triangle.Multiply(solution) == rhs);
+  }
+}
+
+TEST(Triangular, Determinant) {
+  const int size = 300;
+  S21Matrix upper(size, size);
+  S21TriangularMatrix lower(size, S21TriangularMatrix::Uplo::kLower);
+  double expected = 1;
+  for (int i = 0; i < size; i++) {
+    for (int j = i; j < size; j++) {
+      upper(i, j) = j == i ? 1 + (i % 3) * 0.25 : 1000.0 + j;
+    }
+    lower(i, i) = upper(i, i);
+    expected *= upper(i, i);
+  }
+  EXPECT_TRUE(upper.IsUpperTriangular());
+  EXPECT_FALSE(upper.IsLowerTriangular());
+  EXPECT_DOUBLE_EQ(upper.Determinant(), expected);
+  EXPECT_DOUBLE_EQ(upper.Transpose().Determinant(), expected);
+  EXPECT_DOUBLE_EQ(lower.Determinant(), expected);
+  EXPECT_FALSE(S21Matrix(2, 3).IsUpperTriangular());
+}
+
+TEST(Triangular, Errors) {
+  S21TriangularMatrix lower(4, S21TriangularMatrix::Uplo::kLower);
+  const S21TriangularMatrix &view = lower;
+  EXPECT_THROW(lower(1, 2), std::out_of_range);
+  EXPECT_THROW(lower(4, 0), std::out_of_range);
+  EXPECT_DOUBLE_EQ(view(1, 2), 0);
+  EXPECT_THROW(lower.Solve(S21Matrix(4, 1)), std::logic_error);
+  EXPECT_THROW(lower.Multiply(S21Matrix(3, 1)), std::invalid_argument);
+  EXPECT_THROW(S21TriangularMatrix(0, S21TriangularMatrix::Uplo::kUpper),
+               std::invalid_argument);
+  EXPECT_THROW(S21TriangularMatrix(S21Matrix(2, 3),
+                                   S21TriangularMatrix::Uplo::kUpper),
+               std::logic_error);
+}
+
+TEST(Symmetric, RankUpdates) {
+  S21Matrix a(130, 90), b(130, 90);
+  for (int i = 0; i < 130; i++) {
+    for (int j = 0; j < 90; j++) {
+      a(i, j) = ((i * 5 + j * 7) % 19) / 9.0 - 1;
+      b(i, j) = ((i * 3 + j * 11) % 23) / 11.0 - 1;
+    }
+  }
+  using Trans = S21SymmetricMatrix::Trans;
+  ThreadCountGuard threads(4);
+  S21SymmetricMatrix gram = S21SymmetricMatrix::Syrk(a, Trans::kTrans);
+  S21SymmetricMatrix outer = S21SymmetricMatrix::Syrk(a, Trans::kNoTrans);
+  S21SymmetricMatrix both = S21SymmetricMatrix::Syr2k(a, b, Trans::kTrans);
+  EXPECT_EQ(gram.GetSize(), 90);
+  EXPECT_EQ(outer.GetSize(), 130);
+  EXPECT_TRUE(gram.ToMatrix() == a.Transpose() * a);
+  EXPECT_TRUE(outer.ToMatrix() == a * a.Transpose());
+  EXPECT_TRUE(both.ToMatrix() ==
+              a.Transpose() * b + b.Transpose() * a);
+  EXPECT_TRUE(S21SymmetricMatrix::Syr2k(a, b, Trans::kNoTrans).ToMatrix() ==
+              a * b.Transpose() + b * a.Transpose());
+  EXPECT_THROW(S21SymmetricMatrix::Syr2k(a, S21Matrix(3, 3), Trans::kTrans),
+               std::invalid_argument);
+}
+
+TEST(Symmetric, Arithmetic) {
+  S21Matrix dense(3, 3);
+  dense(0, 0) = 4, dense(1, 0) = 1, dense(1, 1) = 5;
+  dense(2, 0) = -2, dense(2, 1) = 3, dense(2, 2) = 6;
+  S21SymmetricMatrix first(dense), second(3);
+  EXPECT_DOUBLE_EQ(first(0, 2), -2);
+  second(0, 1) = 2;
+  EXPECT_DOUBLE_EQ(second(1, 0), 2);
+  S21SymmetricMatrix sum = first + second * 3;
+  EXPECT_DOUBLE_EQ(sum(1, 0), 7);
+  EXPECT_DOUBLE_EQ(sum(0, 1), 7);
+  sum -= first;
+  sum *= 0.5;
+  EXPECT_TRUE(sum == second * 1.5);
+  EXPECT_FALSE(sum == first);
+  EXPECT_THROW(first += S21SymmetricMatrix(4), std::invalid_argument);
+  EXPECT_THROW(first(3, 0), std::out_of_range);
+  EXPECT_THROW(S21SymmetricMatrix(S21Matrix(2, 3)), std::logic_error);
+}
+
+TEST(Numa, Policies) {
+  S21Matrix source(520, 540);
+  for (int i = 0; i < 520; i++) {
+    for (int j = 0; j < 540; j++) {
+      source(i, j) = (i * 13 + j * 7) % 29 - 14;
+    }
+  }
+  const S21Matrix expected = source * source.Transpose();
+  ThreadCountGuard threads(4);
+  for (auto policy : {S21NumaPolicy::kFirstTouch, S21NumaPolicy::kInterleave,
+                      S21NumaPolicy::kBind, S21NumaPolicy::kDefault}) {
+    S21SetNumaPolicy(policy);
+    EXPECT_EQ(S21GetNumaPolicy(), policy);
+    S21Matrix zero(520, 540), copy(source);
+    EXPECT_DOUBLE_EQ(zero(519, 539), 0);
+    EXPECT_TRUE(copy == source);
+    EXPECT_TRUE(copy * source.Transpose() == expected);
+    copy.SetRows(1);
+    EXPECT_DOUBLE_EQ(copy(0, 539), source(0, 539));
+  }
+}
+
+TEST(Numa, Nodes) {
+  EXPECT_GE(S21GetNumaNodeCount(), 1);
+  S21SetNumaPolicy(S21NumaPolicy::kBind, S21GetNumaNodeCount() - 1);
+  EXPECT_EQ(S21GetNumaNode(), S21GetNumaNodeCount() - 1);
+  S21SetNumaPolicy(S21NumaPolicy::kDefault);
+  EXPECT_THROW(S21SetNumaPolicy(S21NumaPolicy::kBind, S21GetNumaNodeCount()),
+               std::invalid_argument);
+  EXPECT_THROW(S21SetNumaPolicy(S21NumaPolicy::kBind, -1),
+               std::invalid_argument);
+  EXPECT_EQ(S21GetNumaPolicy(), S21NumaPolicy::kDefault);
+}
+
+TEST(HugePages, Modes) {
+  const uintptr_t huge_page = 2 << 20;
+  S21ResetPageCounters();
+  S21Matrix small(10, 10);
+  EXPECT_EQ(S21GetPageCounters().heap, 1);
+  EXPECT_EQ(S21GetHugePagePolicy(), S21HugePagePolicy::kTransparent);
+  S21Matrix large(600, 600);
+  large(599, 599) = 1;
+  const S21Matrix &cells = large;
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&cells(0, 0)) % huge_page, 0u);
+  S21PageCounters counters = S21GetPageCounters();
+  EXPECT_EQ(counters.transparent + counters.regular, 1);
+  S21SetHugePagePolicy(S21HugePagePolicy::kOff);
+  S21Matrix regular(large);
+  EXPECT_EQ(S21GetPageCounters().regular, counters.regular + 1);
+  const S21Matrix &copied = regular;
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&copied(0, 0)) % huge_page, 0u);
+  EXPECT_TRUE(regular == large);
+  S21SetHugePagePolicy(S21HugePagePolicy::kTransparent);
+}
+
+TEST(HugePages, ExplicitFallback) {
+  S21SetHugePagePolicy(S21HugePagePolicy::kExplicit);
+  S21ResetPageCounters();
+  S21Matrix matrix(700, 500);
+  matrix(699, 499) = 3;
+  S21Matrix copy(matrix);
+  S21SetHugePagePolicy(S21HugePagePolicy::kTransparent);
+  const S21PageCounters counters = S21GetPageCounters();
+  EXPECT_EQ(counters.hugetlb + counters.fallbacks, 2);
+  EXPECT_EQ(counters.hugetlb + counters.transparent + counters.regular, 2);
+  EXPECT_DOUBLE_EQ(copy(699, 499), 3);
+  EXPECT_DOUBLE_EQ(copy(0, 0), 0);
+}
+
+TEST(CopyOnWrite, SharedUntilModified) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix source(200, 200), rhs(200, 3);
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < 200; j++) {
+      source(i, j) = i == j ? 300 : (i * 3 + j) % 7;
+    }
+    rhs(i, i % 3) = 1;
+  }
+  EXPECT_FALSE(source.IsShared());
+  const S21Matrix copy(source);
+  EXPECT_TRUE(source.IsShared());
+  EXPECT_EQ(&copy(5, 5), &static_cast<const S21Matrix &>(source)(5, 5));
+  S21Matrix changed(copy), assigned;
+  assigned = copy;
+  changed(0, 0) = -1;
+  EXPECT_FALSE(changed.IsShared());
+  EXPECT_DOUBLE_EQ(copy(0, 0), 300);
+  assigned += source;
+  EXPECT_DOUBLE_EQ(assigned(1, 1), 600);
+  S21Matrix solved(rhs);
+  source.Factorize().SolveInPlace(solved);
+  EXPECT_TRUE(source * solved == rhs);
+  EXPECT_TRUE(S21Cholesky(copy * copy.Transpose()).IsPositiveDefinite());
+  EXPECT_TRUE(S21QR(copy).GetR() == S21QR(source).GetR());
+  EXPECT_DOUBLE_EQ(source(0, 0), 300);
+  EXPECT_DOUBLE_EQ(copy(199, 0), (199 * 3) % 7);
+  EXPECT_DOUBLE_EQ(rhs(0, 0), 1);
+  S21Matrix::SetCopyOnWrite(false);
+  S21Matrix deep(source);
+  EXPECT_FALSE(deep.IsShared());
+}
+
+TEST(CopyOnWrite, FanOut) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix source(64, 64);
+  for (int i = 0; i < 64; i++) {
+    source(i, i) = i;
+  }
+  const S21Matrix &shared = source;
+  std::atomic<int> mismatches{0};
+  ThreadCountGuard threads(4);
+  S21ThreadPool::Instance().ParallelFor(0, 64, 1, [&](int begin, int end) {
+    for (int i = begin; i < end; i++) {
+      S21Matrix local(shared);
+      local(i, i) += 1;
+      local.MulNumber(2);
+      if (local(i, i) != 2 * (i + 1) || shared(i, i) != i) mismatches++;
+    }
+  });
+  S21Matrix::SetCopyOnWrite(false);
+  EXPECT_EQ(mismatches, 0);
+  EXPECT_FALSE(source.IsShared());
+}
+
+TEST(CopyOnWrite, HeldCellDetachesOnWrite) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix m(2, 2);
+  S21Matrix::CellRef r = m(0, 0);
+  S21Matrix copy(m), assigned;
+  assigned = m;
+  EXPECT_TRUE(m.IsShared());
+  r = 42;
+  S21Matrix::SetCopyOnWrite(false);
+  EXPECT_FALSE(m.IsShared());
+  EXPECT_TRUE(copy.IsShared());
+  EXPECT_EQ(static_cast<const S21Matrix &>(copy)(0, 0), 0);
+  EXPECT_EQ(static_cast<const S21Matrix &>(assigned)(0, 0), 0);
+  EXPECT_EQ(m(0, 0), 42);
+}
+
+TEST(Fused, Gemm) {
+  S21Matrix a(70, 50), b(50, 60), c(70, 60);
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 50; j++) a(i, j) = (i * 3 + j) % 11 - 5;
+    for (int j = 0; j < 60; j++) c(i, j) = (i + j * 7) % 13 - 6;
+  }
+  for (int i = 0; i < 50; i++) {
+    for (int j = 0; j < 60; j++) b(i, j) = (i * 5 + j * 2) % 9 - 4;
+  }
+  const S21Matrix original(c);
+  S21Matrix::Gemm(2, a, b, -0.5, c);
+  EXPECT_TRUE(c == a * b * 2 + original * -0.5);
+  c(0, 0) = NAN;
+  S21Matrix::Gemm(1, a, b, 0, c);
+  EXPECT_TRUE(c == a * b);
+  c = original;
+  c.MulAdd(a, b);
+  EXPECT_TRUE(c == original + a * b);
+  S21Matrix square(a * a.Transpose());
+  const S21Matrix expected = square * square * 3 + square;
+  S21Matrix::Gemm(3, square, square, 1, square);
+  EXPECT_TRUE(square == expected);
+  EXPECT_THROW(S21Matrix::Gemm(1, a, a, 1, c), std::invalid_argument);
+  EXPECT_THROW(c.MulAdd(b, a), std::invalid_argument);
+}
+
+TEST(Fused, AliasedGemmClearsWithZeroBeta) {
+  S21Matrix c(2, 2);
+  c(0, 0) = INFINITY;
+  c(1, 1) = 2;
+  const S21Matrix ones =
+      S21Matrix(2, 2).Apply([](double) { return 1.0; });
+  S21Matrix::Gemm(1, c, ones, 0, c);
+  EXPECT_TRUE(std::isinf(c(0, 0)) && c(0, 0) > 0);
+  EXPECT_TRUE(std::isinf(c(0, 1)) && c(0, 1) > 0);
+  EXPECT_EQ(c(1, 0), 2);
+  EXPECT_EQ(c(1, 1), 2);
+  S21Matrix scaled(2, 2);
+  scaled(0, 1) = 1;
+  S21Matrix::Gemm(2, S21Matrix::Identity(2), scaled, 0, scaled);
+  EXPECT_EQ(scaled(0, 1), 2);
+  EXPECT_EQ(scaled(1, 0), 0);
+}
+
+TEST(Fused, AddScaled) {
+  S21Matrix x(300, 200), y(300, 200);
+  for (int i = 0; i < 300; i++) {
+    for (int j = 0; j < 200; j++) {
+      x(i, j) = i - j;
+      y(i, j) = i * 0.5;
+    }
+  }
+  const S21Matrix expected = y + x * -1.5;
+  ThreadCountGuard threads(4);
+  y.AddScaled(x, -1.5);
+  EXPECT_TRUE(y == expected);
+  x.AddScaled(x, 1);
+  EXPECT_DOUBLE_EQ(x(299, 0), 598);
+  EXPECT_THROW(x.AddScaled(S21Matrix(2, 2), 1), std::invalid_argument);
+}
+
+TEST(Chain, PlansCheapestOrder) {
+  S21Matrix a(10, 100), b(100, 5), c(5, 50), d(50, 1);
+  for (S21Matrix *factor : {&a, &b, &c, &d}) {
+    for (int i = 0; i < factor->GetRows(); i++) {
+      for (int j = 0; j < factor->GetCols(); j++) {
+        (*factor)(i, j) = ((i * 7 + j * 3) % 5 - 2) * 0.5;
+      }
+    }
+  }
+  S21MatrixChain chain({a, b, c, d});
+  EXPECT_EQ(chain.GetLength(), 4);
+  EXPECT_EQ(chain.GetOrder(), "(A0 * (A1 * (A2 * A3)))");
+  EXPECT_DOUBLE_EQ(chain.GetOptimalFlops(), 2.0 * (250 + 500 + 1000));
+  EXPECT_DOUBLE_EQ(chain.GetLeftToRightFlops(),
+                   2.0 * (5000 + 2500 + 500));
+  EXPECT_DOUBLE_EQ(chain.GetSavedFlops(), 2.0 * (8000 - 1750));
+  EXPECT_TRUE(chain.Multiply() == a * b * c * d);
+  EXPECT_TRUE(S21Matrix::MultiplyChain({a, b, c}) == a * b * c);
+  EXPECT_TRUE(S21Matrix::MultiplyChain({b}) == b);
+}
+
+TEST(Chain, LongChainAndErrors) {
+  std::vector<S21Matrix> factors;
+  const int dims[] = {30, 2, 40, 3, 35, 1, 45, 4, 30};
+  for (int k = 0; k < 8; k++) {
+    S21Matrix factor(dims[k], dims[k + 1]);
+    for (int i = 0; i < dims[k]; i++) {
+      for (int j = 0; j < dims[k + 1]; j++) {
+        factor(i, j) = ((i + j + k) % 3 - 1) * 0.25;
+      }
+    }
+    factors.push_back(factor);
+  }
+  std::vector<S21Matrix::BlockRef> refs(factors.begin(), factors.end());
+  S21Matrix expected = factors[0];
+  for (int k = 1; k < 8; k++) expected = expected * factors[k];
+  S21MatrixChain chain(refs);
+  EXPECT_LT(chain.GetOptimalFlops(), chain.GetLeftToRightFlops());
+  EXPECT_TRUE(chain.Multiply() == expected);
+  EXPECT_THROW(S21MatrixChain({}), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::MultiplyChain({factors[0], factors[0]}),
+               std::invalid_argument);
+}
+
+TEST(TiledLU, MatchesSerialFactorization) {
+  const int n = 300;
+  S21Matrix a(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a(i, j) = ((i * 7 + j * 13) % 31) - 15 + (i == j ? 3 : 0);
+    }
+  }
+  const S21LU serial(a);
+  ThreadCountGuard threads(4);
+  const S21LU tiled(a);
+  EXPECT_EQ(tiled.GetPivots(), serial.GetPivots());
+  EXPECT_TRUE(tiled.GetPacked() == serial.GetPacked());
+  S21Matrix permuted(a);
+  for (int i = 0; i < n; i++) {
+    const int pivot = tiled.GetPivots()[i];
+    for (int j = 0; j < n && pivot != i; j++) {
+      swap(permuted(i, j), permuted(pivot, j));
+    }
+  }
+  EXPECT_TRUE(tiled.GetL() * tiled.GetU() == permuted);
+  EXPECT_NEAR(tiled.Determinant() / serial.Determinant(), 1, 1e-12);
+}
+
+TEST(TiledLU, SingularAndNested) {
+  S21Matrix singular(200, 200);
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < 200; j++) {
+      singular(i, j) = j == 100 ? 0 : (i * j) % 17 + (i == j ? 40 : 0);
+    }
+  }
+  ThreadCountGuard threads(4);
+  EXPECT_TRUE(S21LU(singular).IsSingular());
+  std::atomic<int> failures{0};
+  S21ThreadPool::Instance().ParallelFor(0, 8, 1, [&](int begin, int end) {
+    for (int k = begin; k < end; k++) {
+      S21Matrix local(150, 150);
+      for (int i = 0; i < 150; i++) {
+        for (int j = 0; j < 150; j++) {
+          local(i, j) = (i + 2 * j + k) % 7 + (i == j ? 20 : 0);
+        }
+      }
+      S21Matrix rhs(150, 1);
+      rhs(k, 0) = 1;
+      if (!(local * S21LU(local).Solve(rhs) == rhs)) failures++;
+    }
+  });
+  EXPECT_EQ(failures, 0);
+}
+
+TEST(TiledLU, ConcurrentFactorizations) {
+  std::vector<S21Matrix> matrices(3, S21Matrix(200, 200));
+  for (int k = 0; k < 3; k++) {
+    for (int i = 0; i < 200; i++) {
+      for (int j = 0; j < 200; j++) {
+        matrices[k](i, j) = (i * (k + 3) + j * 5) % 11 + (i == j ? 9 : 0);
+      }
+    }
+  }
+  std::vector<S21Matrix> serial;
+  {
+    ThreadCountGuard threads(1);
+    for (const S21Matrix &matrix : matrices) {
+      serial.push_back(S21LU(matrix).GetPacked());
+    }
+  }
+  // Every thread runs a factorization, so a runner without ready tiles has
+  // to pick up the tasks of the other factorizations
+  ThreadCountGuard threads(2);
+  std::atomic<int> failures{0};
+  S21ThreadPool::Instance().ParallelFor(0, 3, 1, [&](int begin, int end) {
+    for (int k = begin; k < end; k++) {
+      if (!(S21LU(matrices[k]).GetPacked() == serial[k])) failures++;
+    }
+  });
+  EXPECT_EQ(failures, 0);
+}
+
+TEST(Reductions, SmallMatrix) {
+  S21Matrix a(3, 3);
+  const double values[] = {1, -7, 2, 4, 5, -6, 3, 8, -9};
+  for (int i = 0; i < 9; i++) {
+    a(i / 3, i % 3) = values[i];
+  }
+  EXPECT_DOUBLE_EQ(a.Trace(), -3);
+  EXPECT_DOUBLE_EQ(a.Sum(), 1);
+  EXPECT_DOUBLE_EQ(a.Norm(), sqrt(285.0));
+  EXPECT_DOUBLE_EQ(a.Norm(S21Matrix::NormType::kOne), 20);
+  EXPECT_DOUBLE_EQ(a.Norm(S21Matrix::NormType::kInf), 20);
+  EXPECT_DOUBLE_EQ(a.Norm(S21Matrix::NormType::kMax), 9);
+  EXPECT_DOUBLE_EQ(a.Min(), -9);
+  EXPECT_DOUBLE_EQ(a.Max(), 8);
+  EXPECT_EQ(a.ArgMin(), std::make_pair(2, 2));
+  EXPECT_EQ(a.ArgMax(), std::make_pair(2, 1));
+  EXPECT_DOUBLE_EQ(a.Dot(a), 285);
+  EXPECT_DOUBLE_EQ(a.Dot(S21Matrix::Identity(3)), -3);
+  EXPECT_DOUBLE_EQ(S21Matrix().Norm(), 0);
+  EXPECT_THROW(S21Matrix().ArgMax(), std::logic_error);
+  EXPECT_THROW(S21Matrix(2, 3).Trace(), std::logic_error);
+  EXPECT_THROW(a.Dot(S21Matrix(3, 2)), std::invalid_argument);
+}
+
+TEST(Reductions, LargeMatrix) {
+  S21Matrix a(400, 300);
+  for (int i = 0; i < 400; i++) {
+    for (int j = 0; j < 300; j++) {
+      a(i, j) = 0.1 * ((i * 31 + j * 17) % 23 - 11);
+    }
+  }
+  a(371, 5) = 4;
+  a(390, 7) = 4;
+  long double sum = 0, squares = 0;
+  for (int i = 0; i < 400; i++) {
+    for (int j = 0; j < 300; j++) {
+      sum += a(i, j);
+      squares += static_cast<long double>(a(i, j)) * a(i, j);
+    }
+  }
+  const double serial = a.Sum(), norm = a.Norm();
+  ThreadCountGuard threads(4);
+  EXPECT_EQ(a.Sum(), serial);
+  EXPECT_EQ(a.Norm(), norm);
+  EXPECT_EQ(a.ArgMax(), std::make_pair(371, 5));
+  EXPECT_NEAR(serial, static_cast<double>(sum), 1e-11);
+  EXPECT_NEAR(norm, static_cast<double>(sqrtl(squares)), 1e-9);
+  EXPECT_DOUBLE_EQ(a.Dot(a), norm * norm);
+  a.MulNumber(1e200);
+  EXPECT_NEAR(a.Norm() / norm, 1e200, 1e188);
+  a.MulNumber(1e-200);
+  a.MulNumber(1e-200);
+  EXPECT_NEAR(a.Norm() / norm * 1e200, 1, 1e-12);
+}
+
+TEST(Reductions, NaNPropagates) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  S21Matrix a(3, 3);
+  for (int i = 0; i < 9; i++) {
+    a(i / 3, i % 3) = i - 4;
+  }
+  a(1, 2) = nan;
+  for (auto type : {S21Matrix::NormType::kFrobenius, S21Matrix::NormType::kOne,
+                    S21Matrix::NormType::kInf, S21Matrix::NormType::kMax}) {
+    EXPECT_TRUE(std::isnan(a.Norm(type)));
+  }
+  EXPECT_TRUE(std::isnan(a.Min()));
+  EXPECT_TRUE(std::isnan(a.Max()));
+  EXPECT_EQ(a.ArgMin(), std::make_pair(1, 2));
+  EXPECT_EQ(a.ArgMax(), std::make_pair(1, 2));
+  a(0, 1) = nan;
+  EXPECT_EQ(a.ArgMax(), std::make_pair(0, 1));
+}
+
+TEST(Reductions, NaNInLaterChunk) {
+  S21Matrix a(200, 200);
+  for (int i = 0; i < 200; i++) {
+    for (int j = 0; j < 200; j++) {
+      a(i, j) = (i * 7 + j * 3) % 13 - 6;
+    }
+  }
+  a(150, 3) = std::numeric_limits<double>::quiet_NaN();
+  a(170, 9) = 1e9;
+  ThreadCountGuard threads(4);
+  EXPECT_TRUE(std::isnan(a.Norm(S21Matrix::NormType::kMax)));
+  EXPECT_TRUE(std::isnan(a.Norm(S21Matrix::NormType::kInf)));
+  EXPECT_EQ(a.ArgMax(), std::make_pair(150, 3));
+  EXPECT_EQ(a.ArgMin(), std::make_pair(150, 3));
+}
+
+TEST(Elementwise, ApplyAndZip) {
+  S21Matrix a(2, 3);
+  for (int i = 0; i < 6; i++) {
+    a(i / 3, i % 3) = i - 2;
+  }
+  const S21Matrix clamped =
+      a.Apply([](double x) { return std::min(std::max(x, -1.0), 1.0); });
+  EXPECT_DOUBLE_EQ(clamped(0, 0), -1);
+  EXPECT_DOUBLE_EQ(clamped(0, 2), 0);
+  EXPECT_DOUBLE_EQ(clamped(1, 2), 1);
+  EXPECT_DOUBLE_EQ(a(1, 2), 3);
+  S21Matrix b(a);
+  b.ApplyInPlace([](double x) { return x * x; });
+  EXPECT_TRUE(a.Hadamard(a) == b);
+  const S21Matrix sum = a.Zip(b, [](double x, double y) { return x + y; });
+  EXPECT_TRUE(sum == a + b);
+  b.ZipInPlace(a, [](double x, double y) { return x > y ? x : y; });
+  EXPECT_DOUBLE_EQ(b(0, 2), 0);
+  EXPECT_DOUBLE_EQ(b(1, 2), 9);
+  S21Matrix c = a.Divide(S21Matrix(2, 3));
+  EXPECT_TRUE(std::isinf(c(0, 0)) && std::isnan(c(0, 2)));
+  EXPECT_THROW(a.Zip(S21Matrix(3, 2), [](double x, double) { return x; }),
+               std::invalid_argument);
+  S21Matrix empty;
+  empty.ApplyInPlace([](double x) { return x + 1; });
+  EXPECT_EQ(empty.GetRows(), 0);
+}
+
+TEST(Elementwise, Parallel) {
+  S21Matrix a(300, 250), b(300, 250);
+  for (int i = 0; i < 300; i++) {
+    for (int j = 0; j < 250; j++) {
+      a(i, j) = (i * 13 + j * 7) % 29 - 14;
+      b(i, j) = (i + j) % 5 + 1;
+    }
+  }
+  const S21Matrix serial =
+      a.Zip(b, [](double x, double y) { return 1 / (1 + exp(-x * y)); });
+  ThreadCountGuard threads(4);
+  const S21Matrix parallel =
+      a.Zip(b, [](double x, double y) { return 1 / (1 + exp(-x * y)); },
+            S21Matrix::Execution::kParallel);
+  S21Matrix quotient = a.Hadamard(b);
+  quotient.DivideInPlace(b);
+  EXPECT_EQ(serial.Dot(serial), parallel.Dot(parallel));
+  EXPECT_TRUE(quotient == a);
+  const unsigned long long version = quotient.GetVersion();
+  quotient.ApplyInPlace([](double x) { return x; },
+                        S21Matrix::Execution::kParallel);
+  EXPECT_NE(quotient.GetVersion(), version);
+}
+
+TEST(Semiring, TropicalProducts) {
+  const double inf = std::numeric_limits<double>::infinity();
+  S21Matrix distances(4, 4);
+  const double weights[] = {0,   3, inf, 7,   8, 0,   2, inf,
+                            5, inf,   0, 1,   2, inf, inf, 0};
+  for (int i = 0; i < 16; i++) {
+    distances(i / 4, i % 4) = weights[i];
+  }
+  S21Matrix paths(distances);
+  paths.MulMatrix(paths, S21Matrix::Semiring::kMinPlus);
+  paths.MulMatrix(paths, S21Matrix::Semiring::kMinPlus);
+  const double shortest[] = {0, 3, 5, 6, 5, 0, 2, 3, 3, 6, 0, 1, 2, 5, 7, 0};
+  for (int i = 0; i < 16; i++) {
+    EXPECT_DOUBLE_EQ(paths(i / 4, i % 4), shortest[i]);
+  }
+  S21Matrix a(130, 70), b(70, 90);
+  for (int i = 0; i < 130; i++) {
+    for (int j = 0; j < 70; j++) a(i, j) = (i * 7 + j * 3) % 11;
+  }
+  for (int i = 0; i < 70; i++) {
+    for (int j = 0; j < 90; j++) b(i, j) = (i * 5 + j) % 13;
+  }
+  S21Matrix longest(a), product(a);
+  longest.MulMatrix(b, S21Matrix::Semiring::kMaxPlus);
+  product.MulMatrix(b, S21Matrix::Semiring::kPlusTimes);
+  EXPECT_TRUE(product == a * b);
+  for (int i = 0; i < 130; i += 43) {
+    for (int j = 0; j < 90; j += 17) {
+      double best = -inf;
+      for (int p = 0; p < 70; p++) best = std::max(best, a(i, p) + b(p, j));
+      EXPECT_DOUBLE_EQ(longest(i, j), best);
+    }
+  }
+  EXPECT_THROW(a.MulMatrix(a, S21Matrix::Semiring::kMinPlus),
+               std::invalid_argument);
+}
+
+TEST(Semiring, BitMatrix) {
+  const int n = 150;
+  S21Matrix adjacency(n, n);
+  for (int i = 0; i < n; i++) {
+    adjacency(i, (i * 7 + 3) % n) = 1;
+    if (i % 5 == 0) adjacency(i, (i + 1) % n) = 2.5;
+  }
+  const S21BitMatrix bits(adjacency);
+  EXPECT_EQ(bits.Count(), n + n / 5);
+  EXPECT_TRUE(bits.Get(5, 6) && !bits.Get(6, 5));
+  S21Matrix dense(adjacency);
+  dense.MulMatrix(adjacency, S21Matrix::Semiring::kBoolean);
+  S21Matrix expected = adjacency * adjacency;
+  expected.ApplyInPlace([](double x) { return x != 0 ? 1.0 : 0.0; });
+  EXPECT_TRUE(dense == expected);
+  EXPECT_TRUE((bits * bits).ToMatrix() == expected);
+  S21BitMatrix reach(bits), power(bits);
+  for (int step = 1; step < n; step++) {
+    power.MulMatrix(bits);
+    reach.SumMatrix(power);
+  }
+  {
+    ThreadCountGuard threads(4);
+    EXPECT_TRUE(bits.TransitiveClosure() == reach);
+  }
+  EXPECT_TRUE(bits.TransitiveClosure() == reach);
+  S21BitMatrix edge(2, 70);
+  edge.Set(1, 69, true);
+  edge.Set(1, 69, false);
+  EXPECT_EQ(edge.Count(), 0);
+  EXPECT_THROW(edge.Get(2, 0), std::out_of_range);
+  EXPECT_THROW(edge.TransitiveClosure(), std::logic_error);
+  EXPECT_THROW(edge * edge, std::invalid_argument);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();